@@ -25,6 +25,6 @@ public class ALSV4_CPP : ModuleRules
 			"DeveloperSettings"
 		});
 
-		PrivateDependencyModuleNames.AddRange(new[] {"Slate", "SlateCore"});
+		PrivateDependencyModuleNames.AddRange(new[] {"Slate", "SlateCore", "Json"});
 	}
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "ALS_Settings.h"
+
+UALS_Settings::UALS_Settings()
+{
+	// Default animation LOD tiers. Tier 0 runs everything, the last tier updates at a quarter rate with no extras.
+	FALSAnimLODTier& Near = AnimLODTiers.AddDefaulted_GetRef();
+	Near.MaxDistance = 1500.0f;
+	Near.MinScreenSize = 0.1f;
+
+	FALSAnimLODTier& Medium = AnimLODTiers.AddDefaulted_GetRef();
+	Medium.MaxDistance = 3000.0f;
+	Medium.MinScreenSize = 0.05f;
+	Medium.bDynamicTransitions = false;
+
+	FALSAnimLODTier& Far = AnimLODTiers.AddDefaulted_GetRef();
+	Far.MaxDistance = 6000.0f;
+	Far.MinScreenSize = 0.02f;
+	Far.bFootIK = false;
+	Far.bDynamicTransitions = false;
+	Far.bLandPrediction = false;
+
+	FALSAnimLODTier& Distant = AnimLODTiers.AddDefaulted_GetRef();
+	Distant.MaxDistance = BIG_NUMBER;
+	Distant.UpdateInterval = 4;
+	Distant.bFootIK = false;
+	Distant.bDynamicTransitions = false;
+	Distant.bTurnInPlace = false;
+	Distant.bAimSmoothing = false;
+	Distant.bLandPrediction = false;
+}
@@ -10,13 +10,23 @@
 #include "ALS_Settings.h"
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Library/ALSMathLibrary.h"
+#include "Library/ALSCurveCache.h"
+#include "Library/ALSLocomotionCoreConversion.h"
+#include "Library/ALSMovementModel.h"
+#include "Library/ALSStats.h"
+#include "Character/ALSCharacterTickSubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/TimelineComponent.h"
 #include "Curves/CurveVector.h"
 #include "Curves/CurveFloat.h"
+#include "Animation/AnimMontage.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/WorldSettings.h"
 #include "Character/ALSCharacterMovementComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
 #if WITH_EDITOR
@@ -40,6 +50,10 @@ void AALSBaseCharacter::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 	MyCharacterMovementComponent = Cast<UALSCharacterMovementComponent>(Super::GetMovementComponent());
+
+	UWorld* World = GetWorld();
+	check(World);
+	CurveCache = World->GetSubsystem<UALSCurveCacheSubsystem>();
 }
 
 void AALSBaseCharacter::NotifyHit(UPrimitiveComponent* MyComp, AActor* Other, UPrimitiveComponent* OtherComp,
@@ -102,15 +116,68 @@ void AALSBaseCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME(AALSBaseCharacter, TargetRagdollLocation);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedRagdollSnapshot, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedMontage, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedCurrentAcceleration, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedControlRotation, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedStates, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, DesiredGait, COND_OwnerOnly);
+}
+
+void AALSBaseCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	SyncReplicatedStates();
+
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	DOREPLIFETIME_ACTIVE_OVERRIDE(AALSBaseCharacter, TargetRagdollLocation, !Settings->bUseRagdollSnapshots);
+	DOREPLIFETIME_ACTIVE_OVERRIDE(AALSBaseCharacter, ReplicatedRagdollSnapshot, Settings->bUseRagdollSnapshots);
+
+	if (Settings->bUseReplicationBuckets) { UpdateReplicationBucket(); }
+}
+
+float AALSBaseCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer,
+										AActor* ViewTarget, UActorChannel* InChannel, const float Time,
+										const bool bLowBandwidth)
+{
+	const float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+
+	// The view direction is already accounted for by the actor priority, only scale it by distance
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	if (!Settings->bUseReplicationBuckets || ViewTarget == this) { return Priority; }
 
-	DOREPLIFETIME(AALSBaseCharacter, DesiredGait);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, DesiredStance, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, DesiredRotationMode, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, RotationMode, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, OverlayState, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, FlightMode, COND_SkipOwner);
+	switch (GetReplicationBucket(ViewPos))
+	{
+	case EALSReplicationBucket::Mid: return Priority * Settings->MidNetPriorityScale;
+	case EALSReplicationBucket::Far: return Priority * Settings->FarNetPriorityScale;
+	default: return Priority;
+	}
+}
+
+bool AALSBaseCharacter::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget,
+										 const FVector& SrcLocation) const
+{
+	if (!Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation)) { return false; }
+
+	// Unreliable multicasts check the relevancy of every connection, leave the far ones out of cosmetic events
+	if (bSendingCosmeticEvent && ViewTarget != this
+		&& GetReplicationBucket(SrcLocation) == EALSReplicationBucket::Far)
+	{
+		FALSStats::CountCulledCosmeticEvent();
+		return false;
+	}
+
+	return true;
+}
+
+EALSReplicationBucket AALSBaseCharacter::GetReplicationBucket(const FVector& ViewLocation) const
+{
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	const float DistSquared = FVector::DistSquared(GetActorLocation(), ViewLocation);
+	if (DistSquared <= FMath::Square(Settings->NearReplicationDistance)) { return EALSReplicationBucket::Near; }
+	if (DistSquared <= FMath::Square(Settings->FarReplicationDistance)) { return EALSReplicationBucket::Mid; }
+	return EALSReplicationBucket::Far;
 }
 
 void AALSBaseCharacter::BeginPlay()
@@ -120,14 +187,7 @@ void AALSBaseCharacter::BeginPlay()
 	// If we're in networked game, use this to disable curved movement
 	bIsNetworked = !IsNetMode(NM_Standalone);
 
-	FOnTimelineFloat TimelineUpdated;
-	FOnTimelineEvent TimelineFinished;
-	TimelineUpdated.BindUFunction(this, FName(TEXT("MantleUpdate")));
-	TimelineFinished.BindUFunction(this, FName(TEXT("MantleEnd")));
-	MantleTimeline->SetTimelineFinishedFunc(TimelineFinished);
-	MantleTimeline->SetLooping(false);
-	MantleTimeline->SetTimelineLengthMode(TL_TimelineLength);
-	MantleTimeline->AddInterpFloat(MantleTimelineCurve, TimelineUpdated);
+	NearNetUpdateFrequency = NetUpdateFrequency;
 
 	// Make sure the mesh and AnimBP update after the CharacterBP to ensure it gets the most recent values.
 	GetMesh()->AddTickPrerequisiteActor(this);
@@ -135,15 +195,6 @@ void AALSBaseCharacter::BeginPlay()
 	// Set the Movement Model
 	SetMovementModel();
 
-	// Once, force set variables in anim bp. This ensures anim instance & character starts synchronized
-	FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-	MainAnimInstance->Gait = DesiredGait;
-	MainAnimInstance->Stance = DesiredStance;
-	MainAnimInstance->RotationMode = DesiredRotationMode;
-	MainAnimInstance->OverlayState = OverlayState;
-	AnimData.PrevMovementState = PrevMovementState;
-	MainAnimInstance->MovementState = MovementState;
-
 	// Update states to use the initial desired values.
 	SetGait(DesiredGait);
 	SetStance(DesiredStance);
@@ -157,11 +208,53 @@ void AALSBaseCharacter::BeginPlay()
 	TargetRotation = GetActorRotation();
 	LastVelocityRotation = TargetRotation;
 	LastMovementInputRotation = TargetRotation;
+	StepRotation = TargetRotation;
+	PreviousStepRotation = TargetRotation;
+	InterpolatedStepRotation = TargetRotation;
 
 	if (GetLocalRole() == ROLE_SimulatedProxy)
 	{
 		MainAnimInstance->SetRootMotionMode(ERootMotionMode::IgnoreRootMotion);
 	}
+
+	// Once, publish the initial state. This ensures anim instance & character starts synchronized
+	PublishAnimCharacterInformation();
+
+	if (MainAnimInstance) { MainAnimInstance->OnMontageStarted.AddDynamic(this, &AALSBaseCharacter::OnAnimMontageStarted); }
+
+	// Let the batched character tick take over the actor tick, if enabled
+	UWorld* World = GetWorld();
+	check(World);
+	if (UALS_Settings::Get()->bUseBatchedCharacterTick && World->IsGameWorld())
+	{
+		CharacterTickSubsystem = World->GetSubsystem<UALSCharacterTickSubsystem>();
+		if (CharacterTickSubsystem) { CharacterTickSubsystem->RegisterCharacter(this); }
+	}
+
+#if WITH_EDITOR
+	// Pick up edits to the movement model data table
+	World->GetSubsystem<UALSMovementModelSubsystem>()->OnMovementModelsChanged.AddUObject(
+		this, &AALSBaseCharacter::SetMovementModel);
+#endif
+}
+
+void AALSBaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	WakeFromIdle();
+
+	if (CharacterTickSubsystem)
+	{
+		CharacterTickSubsystem->UnregisterCharacter(this);
+		CharacterTickSubsystem = nullptr;
+	}
+
+#if WITH_EDITOR
+	UWorld* World = GetWorld();
+	UALSMovementModelSubsystem* MovementModelSubsystem = World ? World->GetSubsystem<UALSMovementModelSubsystem>() : nullptr;
+	if (MovementModelSubsystem) { MovementModelSubsystem->OnMovementModelsChanged.RemoveAll(this); }
+#endif
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AALSBaseCharacter::PreInitializeComponents()
@@ -178,13 +271,56 @@ void AALSBaseCharacter::PreInitializeComponents()
 	}
 }
 
+void AALSBaseCharacter::PostNetReceive()
+{
+	Super::PostNetReceive();
+
+	// Any replicated change, movement included, may need the full tick rate
+	WakeFromIdle();
+}
+
 void AALSBaseCharacter::Tick(const float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CharacterTick);
+	CSV_SCOPED_TIMING_STAT(ALS, CharacterTick);
+	FALSBenchmarkScope BenchmarkScope(FALSBenchmarkCounters::CharacterTickCycles);
+
 	Super::Tick(DeltaTime);
 
-	// Set required values
-	SetEssentialValues(DeltaTime);
+	if (UALS_Settings::Get()->bUseFixedStepLocomotion) { TickFixedStepLocomotion(DeltaTime); }
+	else
+	{
+		ResetMeshStepRotation();
+
+		// Set required values, unless the batched tick already did in its parallel phase
+		if (!HasLocomotionFrame(DeltaTime)) { SetEssentialValues(DeltaTime); }
+
+		UpdateLocomotion(DeltaTime);
+
+		// Cache values
+		PreviousVelocity = GetVelocity();
+		PreviousAimYaw = AimingRotation.Yaw;
+	}
+
+	// Hand this frame's state over to the anim instance. The mesh ticks after the character.
+	PublishAnimCharacterInformation();
+
+	// Send the states changed this frame to the server, in one call
+	if (PendingServerStates.FieldMask != 0)
+	{
+		Server_SetStates(PendingServerStates);
+		PendingServerStates.FieldMask = 0;
+	}
+
+	if (UALS_Settings::Get()->bUseIdleTickRate) { UpdateIdleState(DeltaTime); }
 
+#if WITH_EDITOR
+	if (DrawDebug) DrawDebugSpheres();
+#endif
+}
+
+void AALSBaseCharacter::UpdateLocomotion(const float DeltaTime)
+{
 	switch (MovementState)
 	{
 	case EALSMovementState::None: break;
@@ -200,7 +336,7 @@ void AALSBaseCharacter::Tick(const float DeltaTime)
 	case EALSMovementState::Freefall: UpdateFallingRotation(DeltaTime);
 
 		// Perform a mantle check if falling while movement input is pressed or the constant check flag is true.
-		if (bHasMovementInput || bAlwaysCatchIfFalling) { MantleCheckFalling(); }
+		if ((bHasMovementInput || bAlwaysCatchIfFalling) && IsLocallyControlled()) { MantleCheckFalling(); }
 		break;
 	case EALSMovementState::Flight: UpdateRelativeAltitude();
 		UpdateCharacterMovement(DeltaTime);
@@ -215,20 +351,83 @@ void AALSBaseCharacter::Tick(const float DeltaTime)
 		break;
 	default: break;
 	}
+}
 
-	// Cache values
-	PreviousVelocity = GetVelocity();
-	PreviousAimYaw = AimingRotation.Yaw;
+void AALSBaseCharacter::TickFixedStepLocomotion(const float DeltaTime)
+{
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	const float StepTime = 1.0f / Settings->FixedLocomotionStepRate;
 
-#if WITH_EDITOR
-	if (DrawDebug) DrawDebugSpheres();
-#endif
+	// Simulated proxies don't simulate or replicate their rotation, they show the interpolated one on the actor.
+	// Locally controlled characters keep the actor at the simulated rotation for the movement component, and only
+	// show the interpolated one on the mesh. Servers don't render remote characters, and ragdolls move the mesh.
+	const bool bInterpolateActor = GetLocalRole() == ROLE_SimulatedProxy;
+	const bool bInterpolateMesh = IsLocallyControlled() && !IsNetMode(NM_DedicatedServer) &&
+		MovementState != EALSMovementState::Ragdoll;
+
+	// Step 1: Find the steps due this frame. Steps over the limit are dropped.
+	LocomotionStepAccumulator += DeltaTime;
+	const int32 DueSteps = FMath::FloorToInt(LocomotionStepAccumulator / StepTime);
+	const int32 Steps = FMath::Min(DueSteps, Settings->MaxLocomotionStepsPerFrame);
+	LocomotionStepAccumulator -= DueSteps * StepTime;
+
+	// Step 2: Restart the interpolation if anything else rotated the character since the last frame.
+	const FRotator& ShownActorRotation = bInterpolateActor ? InterpolatedStepRotation : StepRotation;
+	if (!GetActorRotation().Equals(ShownActorRotation, 0.01f))
+	{
+		StepRotation = GetActorRotation();
+		PreviousStepRotation = StepRotation;
+	}
+
+	if (Steps > 0)
+	{
+		// Take the actor rotation back from the interpolation
+		if (bInterpolateActor) { SetActorRotation(StepRotation); }
+		PreviousStepRotation = StepRotation;
+
+		// Step 3: Set the essential values once, over all the simulated time since the last step. Rates are then
+		// measured over whole steps, and running several steps after a hitch doesn't see a zero acceleration.
+		SetEssentialValues(DueSteps * StepTime);
+
+		for (int32 Step = 0; Step < Steps; ++Step) { UpdateLocomotion(StepTime); }
+
+		PreviousVelocity = GetVelocity();
+		PreviousAimYaw = AimingRotation.Yaw;
+
+		StepRotation = GetActorRotation();
+	}
+
+	// Step 4: Show the rotation between the last two steps, one step behind the simulation.
+	if (!bInterpolateMesh) { ResetMeshStepRotation(); }
+	if (!bInterpolateActor && !bInterpolateMesh) { return; }
+
+	const float Alpha = FMath::Clamp(LocomotionStepAccumulator / StepTime, 0.0f, 1.0f);
+	const FQuat InterpolatedQuat = FQuat::Slerp(PreviousStepRotation.Quaternion(), StepRotation.Quaternion(), Alpha);
+	if (bInterpolateActor)
+	{
+		InterpolatedStepRotation = InterpolatedQuat.Rotator();
+		SetActorRotation(InterpolatedStepRotation);
+	}
+	else
+	{
+		// Rotate the mesh around the actor by the difference, as the movement component's network smoothing does
+		const FQuat MeshOffset = GetActorQuat().Inverse() * InterpolatedQuat;
+		GetMesh()->SetRelativeLocationAndRotation(MeshOffset.RotateVector(GetBaseTranslationOffset()),
+												  MeshOffset * GetBaseRotationOffset());
+		bMeshStepRotationOffset = true;
+	}
+}
+
+void AALSBaseCharacter::ResetMeshStepRotation()
+{
+	if (!bMeshStepRotationOffset) { return; }
+	bMeshStepRotationOffset = false;
+	GetMesh()->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
 }
 
 void AALSBaseCharacter::SetAimYawRate(const float NewAimYawRate)
 {
 	AimYawRate = NewAimYawRate;
-	MainAnimInstance->GetCharacterInformationMutable().AimYawRate = AimYawRate;
 }
 
 void AALSBaseCharacter::RagdollStart()
@@ -239,6 +438,9 @@ void AALSBaseCharacter::RagdollStart()
 	*/
 	MyCharacterMovementComponent->bIgnoreClientMovementErrorChecksAndCorrection = 1;
 
+	// Put the mesh back on the capsule before it simulates, the fixed step interpolation stops while ragdolling
+	ResetMeshStepRotation();
+
 	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
 	{
 		DefVisBasedTickOp = GetMesh()->VisibilityBasedAnimTickOption;
@@ -246,6 +448,8 @@ void AALSBaseCharacter::RagdollStart()
 	}
 	TargetRagdollLocation = GetMesh()->GetSocketLocation(FName(TEXT("Pelvis")));
 	ServerRagdollPull = 0;
+	RagdollSnapshots.Reset();
+	LastRagdollSnapshotTime = -BIG_NUMBER;
 
 	// Step 1: Clear the Character Movement Mode and set the Movement State to Ragdoll
 	GetCharacterMovement()->SetMovementMode(MOVE_None);
@@ -311,9 +515,8 @@ void AALSBaseCharacter::SetMovementState(const EALSMovementState NewState)
 	{
 		PrevMovementState = MovementState;
 		MovementState = NewState;
-		FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-		AnimData.PrevMovementState = PrevMovementState;
-		MainAnimInstance->MovementState = MovementState;
+		WakeFromIdle();
+		if (BatchedTickIndex != INDEX_NONE) { CharacterTickSubsystem->SetMovementState(BatchedTickIndex, MovementState); }
 		OnMovementStateChanged(PrevMovementState);
 	}
 }
@@ -324,7 +527,7 @@ void AALSBaseCharacter::SetMovementAction(const EALSMovementAction NewAction)
 	{
 		const EALSMovementAction Prev = MovementAction;
 		MovementAction = NewAction;
-		MainAnimInstance->MovementAction = MovementAction;
+		WakeFromIdle();
 		OnMovementActionChanged(Prev);
 	}
 }
@@ -335,7 +538,7 @@ void AALSBaseCharacter::SetStance(const EALSStance NewStance)
 	{
 		const EALSStance Prev = Stance;
 		Stance = NewStance;
-		MainAnimInstance->Stance = Stance;
+		WakeFromIdle();
 		OnStanceChanged(Prev);
 	}
 }
@@ -345,27 +548,38 @@ void AALSBaseCharacter::SetGait(const EALSGait NewGait)
 	if (Gait != NewGait)
 	{
 		Gait = NewGait;
-		MainAnimInstance->Gait = Gait;
 	}
 }
 
 void AALSBaseCharacter::SetDesiredStance(const EALSStance NewStance)
 {
 	DesiredStance = NewStance;
-	if (GetLocalRole() == ROLE_AutonomousProxy) { Server_SetDesiredStance(NewStance); }
+	if (GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		PendingServerStates.DesiredStance = NewStance;
+		RequestServerStates(FALSReplicatedStates::DesiredStanceField);
+	}
 }
 
 void AALSBaseCharacter::SetDesiredGait(const EALSGait NewGait)
 {
 	DesiredGait = NewGait;
-	if (GetLocalRole() == ROLE_AutonomousProxy) { Server_SetDesiredGait(NewGait); }
+	if (GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		PendingServerStates.DesiredGait = NewGait;
+		RequestServerStates(FALSReplicatedStates::DesiredGaitField);
+	}
 }
 
 void AALSBaseCharacter::SetDesiredRotationMode(const EALSRotationMode NewRotMode)
 {
 	DesiredRotationMode = NewRotMode;
 
-	if (GetLocalRole() == ROLE_AutonomousProxy) { Server_SetDesiredRotationMode(NewRotMode); }
+	if (GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		PendingServerStates.DesiredRotationMode = NewRotMode;
+		RequestServerStates(FALSReplicatedStates::DesiredRotationModeField);
+	}
 }
 
 void AALSBaseCharacter::SetRotationMode(const EALSRotationMode NewRotationMode)
@@ -374,9 +588,14 @@ void AALSBaseCharacter::SetRotationMode(const EALSRotationMode NewRotationMode)
 	{
 		const EALSRotationMode Prev = RotationMode;
 		RotationMode = NewRotationMode;
+		WakeFromIdle();
 		OnRotationModeChanged(Prev);
 
-		if (GetLocalRole() == ROLE_AutonomousProxy) { Server_SetRotationMode(NewRotationMode); }
+		if (GetLocalRole() == ROLE_AutonomousProxy)
+		{
+			PendingServerStates.RotationMode = NewRotationMode;
+			RequestServerStates(FALSReplicatedStates::RotationModeField);
+		}
 	}
 }
 
@@ -393,7 +612,11 @@ void AALSBaseCharacter::SetFlightMode(const EALSFlightMode NewFlightMode)
 	FlightMode = NewFlightMode;
 	OnFlightModeChanged(Prev);
 
-	if (GetLocalRole() == ROLE_AutonomousProxy) { Server_SetFlightMode(NewFlightMode); }
+	if (GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		PendingServerStates.FlightMode = NewFlightMode;
+		RequestServerStates(FALSReplicatedStates::FlightModeField);
+	}
 }
 
 void AALSBaseCharacter::SetOverlayState(const EALSOverlayState NewState)
@@ -402,9 +625,14 @@ void AALSBaseCharacter::SetOverlayState(const EALSOverlayState NewState)
 	{
 		const EALSOverlayState Prev = OverlayState;
 		OverlayState = NewState;
+		WakeFromIdle();
 		OnOverlayStateChanged(Prev);
 
-		if (GetLocalRole() == ROLE_AutonomousProxy) { Server_SetOverlayState(NewState); }
+		if (GetLocalRole() == ROLE_AutonomousProxy)
+		{
+			PendingServerStates.OverlayState = NewState;
+			RequestServerStates(FALSReplicatedStates::OverlayStateField);
+		}
 	}
 }
 
@@ -462,54 +690,73 @@ bool AALSBaseCharacter::MantleCheckVault()
 
 void AALSBaseCharacter::SetMovementModel()
 {
-	const FString ContextString = GetFullName();
-	FALSMovementStateSettings* OutRow =
-		MovementModel.DataTable->FindRow<FALSMovementStateSettings>(MovementModel.RowName, ContextString);
-	check(OutRow);
-	MovementData = *OutRow;
+	UWorld* World = GetWorld();
+	check(World);
+
+	UALSMovementModelSubsystem* MovementModelSubsystem = World->GetSubsystem<UALSMovementModelSubsystem>();
+	check(MovementModelSubsystem);
+	SharedMovementModel = MovementModelSubsystem->FindOrBuild(MovementModel);
+	check(SharedMovementModel);
+
+	// The model may have been rebuilt, force the next update to copy the settings and write the curve values again
+	AppliedMovementEntry = nullptr;
+	MovementCurveBucket = INDEX_NONE;
+	UpdateTargetMovementSettings();
 }
 
-void AALSBaseCharacter::SetHasMovementInput(const bool bNewHasMovementInput)
+void AALSBaseCharacter::UpdateTargetMovementSettings()
 {
-	bHasMovementInput = bNewHasMovementInput;
-	MainAnimInstance->GetCharacterInformationMutable().bHasMovementInput = bHasMovementInput;
+	if (!SharedMovementModel) { return; }
+	TargetMovementEntry = &SharedMovementModel->GetEntry(RotationMode, MovementState, Stance);
 }
 
-FALSMovementSettings AALSBaseCharacter::GetTargetMovementSettings() const
+void AALSBaseCharacter::ApplyTargetMovementSettings()
 {
-	if (RotationMode == EALSRotationMode::VelocityDirection)
-	{
-		if (MovementState == EALSMovementState::Grounded)
-		{
-			if (Stance == EALSStance::Standing) { return MovementData.VelocityDirection.Standing; }
-			if (Stance == EALSStance::Crouching) { return MovementData.VelocityDirection.Crouching; }
-		}
-		if (MovementState == EALSMovementState::Flight) { return MovementData.VelocityDirection.Flying; }
-		if (MovementState == EALSMovementState::Swimming) { return MovementData.VelocityDirection.Swimming; }
-	}
-	else if (RotationMode == EALSRotationMode::LookingDirection)
-	{
-		if (MovementState == EALSMovementState::Grounded)
-		{
-			if (Stance == EALSStance::Standing) { return MovementData.LookingDirection.Standing; }
-			if (Stance == EALSStance::Crouching) { return MovementData.LookingDirection.Crouching; }
-		}
-		if (MovementState == EALSMovementState::Flight) { return MovementData.LookingDirection.Flying; }
-		if (MovementState == EALSMovementState::Swimming) { return MovementData.LookingDirection.Swimming; }
-	}
-	else if (RotationMode == EALSRotationMode::Aiming)
+	if (AppliedMovementEntry == TargetMovementEntry) { return; }
+	AppliedMovementEntry = TargetMovementEntry;
+	CurrentMovementSettings = TargetMovementEntry->Settings;
+}
+
+bool AALSBaseCharacter::EvaluateMovementCurve(FVector& OutCurveVec)
+{
+	float MappedSpeed = GetMappedSpeed();
+
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	if (Settings->bUseChangeDrivenMovementSettings)
 	{
-		if (MovementState == EALSMovementState::Grounded)
+		const int32 Bucket = FMath::RoundToInt(MappedSpeed / Settings->MappedSpeedBucketSize);
+		const EMovementMode CurrentMode = GetCharacterMovement()->MovementMode;
+		if (Bucket == MovementCurveBucket && AppliedMovementEntry == MovementCurveEntry &&
+			CurrentMode == MovementCurveMode)
 		{
-			if (Stance == EALSStance::Standing) { return MovementData.Aiming.Standing; }
-			if (Stance == EALSStance::Crouching) { return MovementData.Aiming.Crouching; }
+			return false;
 		}
-		if (MovementState == EALSMovementState::Flight) { return MovementData.Aiming.Flying; }
-		if (MovementState == EALSMovementState::Swimming) { return MovementData.Aiming.Swimming; }
+
+		MovementCurveBucket = Bucket;
+		MovementCurveEntry = AppliedMovementEntry;
+		MovementCurveMode = CurrentMode;
+		MappedSpeed = Bucket * Settings->MappedSpeedBucketSize;
 	}
 
-	// Default to velocity dir standing
-	return MovementData.VelocityDirection.Standing;
+	OutCurveVec = UALSCurveCacheSubsystem::GetVectorValue(CurrentMovementSettings.MovementCurve,
+														  AppliedMovementEntry->BakedMovementCurve,
+														  MappedSpeed);
+	return true;
+}
+
+void AALSBaseCharacter::SetHasMovementInput(const bool bNewHasMovementInput)
+{
+	bHasMovementInput = bNewHasMovementInput;
+}
+
+FALSMovementSettings AALSBaseCharacter::GetTargetMovementSettings() const
+{
+	return TargetMovementEntry ? TargetMovementEntry->Settings : FALSMovementSettings();
+}
+
+FALSMovementStateSettings AALSBaseCharacter::GetMovementData() const
+{
+	return SharedMovementModel ? SharedMovementModel->Data : FALSMovementStateSettings();
 }
 
 bool AALSBaseCharacter::CanSprint() const
@@ -518,28 +765,25 @@ bool AALSBaseCharacter::CanSprint() const
 	// (input) rotation. If the character is in the Looking Rotation mode, only allow sprinting if there is full
 	// movement input and it is faced forward relative to the camera + or - 50 degrees.
 
-	if (!bHasMovementInput || RotationMode == EALSRotationMode::Aiming) { return false; } // Initial fail condition
+	FALSSprintInputs Inputs;
+	Inputs.RotationMode = ALSLocomotionCore::ToCore(RotationMode);
+	Inputs.bHasMovementInput = bHasMovementInput;
+	Inputs.MovementInputAmount = MovementInputAmount;
 
-	const bool bValidInputAmount = MovementInputAmount > 0.9f;
-
-	if (RotationMode == EALSRotationMode::VelocityDirection) { return bValidInputAmount; }
-
-	if (RotationMode == EALSRotationMode::LookingDirection)
+	if (bHasMovementInput && RotationMode == EALSRotationMode::LookingDirection)
 	{
 		const FRotator AccRot = ReplicatedCurrentAcceleration.ToOrientationRotator();
 		FRotator Delta = AccRot - AimingRotation;
 		Delta.Normalize();
-
-		return bValidInputAmount && FMath::Abs(Delta.Yaw) < 50.0f;
+		Inputs.InputAimYawDelta = Delta.Yaw;
 	}
 
-	return false;
+	return FALSLocomotionCore::CanSprint(Inputs);
 }
 
 void AALSBaseCharacter::SetIsMoving(const bool bNewIsMoving)
 {
 	bIsMoving = bNewIsMoving;
-	MainAnimInstance->GetCharacterInformationMutable().bIsMoving = bIsMoving;
 }
 
 FVector AALSBaseCharacter::GetMovementInput() const { return ReplicatedCurrentAcceleration; }
@@ -547,13 +791,11 @@ FVector AALSBaseCharacter::GetMovementInput() const { return ReplicatedCurrentAc
 void AALSBaseCharacter::SetMovementInputAmount(const float NewMovementInputAmount)
 {
 	MovementInputAmount = NewMovementInputAmount;
-	MainAnimInstance->GetCharacterInformationMutable().MovementInputAmount = MovementInputAmount;
 }
 
 void AALSBaseCharacter::SetSpeed(const float NewSpeed)
 {
 	Speed = NewSpeed;
-	MainAnimInstance->GetCharacterInformationMutable().Speed = Speed;
 }
 
 float AALSBaseCharacter::GetAnimCurveValue(const FName CurveName) const
@@ -582,11 +824,43 @@ void AALSBaseCharacter::SetAcceleration(const FVector& NewAcceleration)
 	Acceleration = (NewAcceleration != FVector::ZeroVector || IsLocallyControlled())
 					   ? NewAcceleration
 					   : Acceleration / 2;
-	MainAnimInstance->GetCharacterInformationMutable().Acceleration = Acceleration;
+}
+
+void AALSBaseCharacter::PublishAnimCharacterInformation()
+{
+	if (!MainAnimInstance) { return; }
+
+	// Fill the snapshot from this frame's state. The view mode is kept up to date by the player character.
+	const UCharacterMovementComponent* MovementComp = GetCharacterMovement();
+	AnimCharacterInformation.AimingRotation = AimingRotation;
+	AnimCharacterInformation.CharacterActorRotation = GetActorRotation();
+	AnimCharacterInformation.Velocity = MovementComp->Velocity;
+	AnimCharacterInformation.Acceleration = Acceleration;
+	AnimCharacterInformation.MovementInput = GetMovementInput();
+	AnimCharacterInformation.bIsMoving = bIsMoving;
+	AnimCharacterInformation.bHasMovementInput = bHasMovementInput;
+	AnimCharacterInformation.Speed = Speed;
+	AnimCharacterInformation.MovementInputAmount = MovementInputAmount;
+	AnimCharacterInformation.AimYawRate = AimYawRate;
+	AnimCharacterInformation.MaxAcceleration = MovementComp->GetMaxAcceleration();
+	AnimCharacterInformation.MaxBrakingDeceleration = MovementComp->GetMaxBrakingDeceleration();
+	AnimCharacterInformation.MeshScale = GetMesh()->GetComponentScale().Z;
+	AnimCharacterInformation.MovementState = MovementState;
+	AnimCharacterInformation.PrevMovementState = PrevMovementState;
+	AnimCharacterInformation.MovementAction = MovementAction;
+	AnimCharacterInformation.RotationMode = RotationMode;
+	AnimCharacterInformation.Gait = Gait;
+	AnimCharacterInformation.Stance = Stance;
+	AnimCharacterInformation.OverlayState = OverlayState;
+
+	MainAnimInstance->PublishCharacterInformation(AnimCharacterInformation);
 }
 
 void AALSBaseCharacter::RagdollUpdate(const float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_RagdollUpdate);
+	CSV_SCOPED_TIMING_STAT(ALS, RagdollUpdate);
+
 	// Set the Last Ragdoll Velocity.
 	const FVector NewRagdollVel = GetMesh()->GetPhysicsLinearVelocity(FName(TEXT("root")));
 	LastRagdollVelocity = NewRagdollVel != FVector::ZeroVector || IsLocallyControlled()
@@ -610,11 +884,22 @@ void AALSBaseCharacter::RagdollUpdate(const float DeltaTime)
 
 void AALSBaseCharacter::SetActorLocationDuringRagdoll(const float DeltaTime)
 {
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	const UWorld* World = GetWorld();
+	check(World);
+
 	if (IsLocallyControlled())
 	{
 		// Set the pelvis as the target location.
 		TargetRagdollLocation = GetMesh()->GetSocketLocation(FName(TEXT("Pelvis")));
-		if (!HasAuthority()) { Server_SetMeshLocationDuringRagdoll(TargetRagdollLocation); }
+		if (Settings->bUseRagdollSnapshots) { SendRagdollSnapshot(); }
+		else if (!HasAuthority()) { Server_SetMeshLocationDuringRagdoll(TargetRagdollLocation); }
+	}
+	else if (Settings->bUseRagdollSnapshots)
+	{
+		// Render one snapshot interval behind, so that there usually is a newer snapshot to interpolate towards
+		RagdollSnapshots.Sample(World->GetTimeSeconds() - 1.0f / Settings->RagdollSnapshotRate,
+								Settings->RagdollMaxExtrapolationTime, TargetRagdollLocation);
 	}
 
 	// Determine whether the ragdoll is facing up or down and set the target rotation accordingly.
@@ -634,7 +919,8 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(const float DeltaTime)
 	Params.AddIgnoredActor(this);
 
 	FHitResult HitResult;
-	GetWorld()->LineTraceSingleByChannel(HitResult, TargetRagdollLocation, TraceVect, ECC_Visibility, Params);
+	FALSStats::CountSceneQuery();
+	World->LineTraceSingleByChannel(HitResult, TargetRagdollLocation, TraceVect, ECC_Visibility, Params);
 
 	bRagdollOnGround = HitResult.IsValidBlockingHit();
 	FVector NewRagdollLoc = TargetRagdollLocation;
@@ -646,7 +932,16 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(const float DeltaTime)
 	}
 	if (!IsLocallyControlled())
 	{
-		ServerRagdollPull = FMath::FInterpTo(ServerRagdollPull, 750, DeltaTime, 0.6);
+		if (Settings->bUseRagdollSnapshots)
+		{
+			// Pull at full strength while interpolating, fading out as the target is extrapolated from older snapshots
+			const float Age = RagdollSnapshots.GetAge(World->GetTimeSeconds()) - 1.0f / Settings->RagdollSnapshotRate;
+			ServerRagdollPull = 750 * (1.0f - FMath::Clamp(Age / Settings->RagdollSnapshotMaxAge, 0.0f, 1.0f));
+		}
+		else
+		{
+			ServerRagdollPull = FMath::FInterpTo(ServerRagdollPull, 750, DeltaTime, 0.6);
+		}
 		float RagdollSpeed = FVector(LastRagdollVelocity.X, LastRagdollVelocity.Y, 0).Size();
 		FName RagdollSocketPullName = RagdollSpeed > 300 ? FName(TEXT("spine_03")) : FName(TEXT("pelvis"));
 		GetMesh()->AddForce(
@@ -656,6 +951,31 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(const float DeltaTime)
 	SetActorLocationAndTargetRotation(bRagdollOnGround ? NewRagdollLoc : TargetRagdollLocation, TargetRagdollRotation);
 }
 
+void AALSBaseCharacter::SendRagdollSnapshot()
+{
+	const float Time = GetWorld()->GetTimeSeconds();
+	if (Time - LastRagdollSnapshotTime < 1.0f / UALS_Settings::Get()->RagdollSnapshotRate) { return; }
+	LastRagdollSnapshotTime = Time;
+
+	FALSRagdollSnapshot Snapshot;
+	Snapshot.Location = TargetRagdollLocation;
+	Snapshot.Velocity = LastRagdollVelocity;
+	Snapshot.Sequence = ReplicatedRagdollSnapshot.Sequence + 1;
+
+	// The server replicates it to the simulated proxies, an owning client sends it to the server to forward
+	ReplicatedRagdollSnapshot = Snapshot;
+	if (!HasAuthority()) { Server_SetRagdollSnapshot(Snapshot); }
+}
+
+void AALSBaseCharacter::ReceiveRagdollSnapshot(const FALSRagdollSnapshot& Snapshot)
+{
+	const UWorld* World = GetWorld();
+	check(World);
+	RagdollSnapshots.Add(Snapshot, World->GetTimeSeconds());
+}
+
+void AALSBaseCharacter::OnRep_RagdollSnapshot() { ReceiveRagdollSnapshot(ReplicatedRagdollSnapshot); }
+
 void AALSBaseCharacter::OnMovementModeChanged(const EMovementMode PrevMovementMode, const uint8 PreviousCustomMode)
 {
 	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
@@ -671,7 +991,10 @@ void AALSBaseCharacter::OnMovementModeChanged(const EMovementMode PrevMovementMo
 	case MOVE_Falling: SetMovementState(EALSMovementState::Freefall); break;
 	case MOVE_Swimming: SetMovementState(EALSMovementState::Swimming); break;
 	case MOVE_Flying: SetMovementState(EALSMovementState::Flight); break;
-	case MOVE_Custom: SetMovementState(EALSMovementState::None); break;
+	case MOVE_Custom: SetMovementState(MyCharacterMovementComponent->IsMantling()
+										   ? EALSMovementState::Mantling
+										   : EALSMovementState::None);
+		break;
 	case MOVE_MAX: SetMovementState(EALSMovementState::None); break;
 	default: SetMovementState(EALSMovementState::None); break;
 	}
@@ -679,6 +1002,8 @@ void AALSBaseCharacter::OnMovementModeChanged(const EMovementMode PrevMovementMo
 
 void AALSBaseCharacter::OnMovementStateChanged(const EALSMovementState PreviousState)
 {
+	UpdateTargetMovementSettings();
+
 	if (MovementState == EALSMovementState::Freefall)
 	{
 		if (MovementAction == EALSMovementAction::None)
@@ -693,11 +1018,6 @@ void AALSBaseCharacter::OnMovementStateChanged(const EALSMovementState PreviousS
 			ReplicatedRagdollStart();
 		}
 	}
-	else if (MovementState == EALSMovementState::Ragdoll && PreviousState == EALSMovementState::Mantling)
-	{
-		// Stop the Mantle Timeline if transitioning to the ragdoll state while mantling.
-		MantleTimeline->Stop();
-	}
 }
 
 void AALSBaseCharacter::OnMovementActionChanged(const EALSMovementAction PreviousAction)
@@ -712,11 +1032,14 @@ void AALSBaseCharacter::OnMovementActionChanged(const EALSMovementAction Previou
 	}
 }
 
-void AALSBaseCharacter::OnStanceChanged(const EALSStance PreviousStance) {}
+void AALSBaseCharacter::OnStanceChanged(const EALSStance PreviousStance)
+{
+	UpdateTargetMovementSettings();
+}
 
 void AALSBaseCharacter::OnRotationModeChanged(const EALSRotationMode PreviousRotationMode)
 {
-	MainAnimInstance->RotationMode = RotationMode;
+	UpdateTargetMovementSettings();
 }
 
 void AALSBaseCharacter::OnFlightModeChanged(const EALSFlightMode PreviousFlightMode)
@@ -735,10 +1058,7 @@ void AALSBaseCharacter::OnFlightModeChanged(const EALSFlightMode PreviousFlightM
 
 void AALSBaseCharacter::OnGaitChanged(const EALSGait PreviousGait) {}
 
-void AALSBaseCharacter::OnOverlayStateChanged(const EALSOverlayState PreviousState)
-{
-	MainAnimInstance->OverlayState = OverlayState;
-}
+void AALSBaseCharacter::OnOverlayStateChanged(const EALSOverlayState PreviousState) {}
 
 void AALSBaseCharacter::OnStartCrouch(const float HalfHeightAdjust, const float ScaledHalfHeightAdjust)
 {
@@ -757,7 +1077,11 @@ void AALSBaseCharacter::Landed(const FHitResult& Hit)
 	Super::Landed(Hit);
 
 	if (IsLocallyControlled()) { EventOnLanded(); }
-	if (HasAuthority()) { Multicast_OnLanded(); }
+	if (HasAuthority())
+	{
+		TGuardValue<bool> CosmeticEventGuard(bSendingCosmeticEvent, UALS_Settings::Get()->bUseReplicationBuckets);
+		Multicast_OnLanded();
+	}
 }
 
 void AALSBaseCharacter::OnLandFrictionReset() const
@@ -768,10 +1092,29 @@ void AALSBaseCharacter::OnLandFrictionReset() const
 
 void AALSBaseCharacter::SetEssentialValues(const float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_SetEssentialValues);
+	CSV_SCOPED_TIMING_STAT(ALS, SetEssentialValues);
+
 	if (GetLocalRole() != ROLE_SimulatedProxy)
 	{
-		ReplicatedCurrentAcceleration = GetCharacterMovement()->GetCurrentAcceleration();
-		ReplicatedControlRotation = GetControlRotation();
+		const FVector NewAcceleration = GetCharacterMovement()->GetCurrentAcceleration();
+		const FRotator NewControlRotation = GetControlRotation();
+
+		// Small changes don't dirty the replicated values on a server. Stopping always does, since it ends the
+		// movement input.
+		const UALS_Settings* Settings = UALS_Settings::Get();
+		const bool bUseThresholds = bIsNetworked && HasAuthority();
+		if (!bUseThresholds || NewAcceleration.IsZero() ||
+			!NewAcceleration.Equals(ReplicatedCurrentAcceleration, Settings->ReplicatedAccelerationThreshold))
+		{
+			ReplicatedCurrentAcceleration = NewAcceleration;
+		}
+		if (!bUseThresholds ||
+			!NewControlRotation.Equals(ReplicatedControlRotation, Settings->ReplicatedControlRotationThreshold))
+		{
+			ReplicatedControlRotation = NewControlRotation;
+		}
+
 		EasedMaxAcceleration = GetCharacterMovement()->GetMaxAcceleration();
 	}
 
@@ -816,13 +1159,127 @@ void AALSBaseCharacter::SetEssentialValues(const float DeltaTime)
 	SetAimYawRate(FMath::Abs((AimingRotation.Yaw - PreviousAimYaw) / DeltaTime));
 }
 
+void AALSBaseCharacter::UpdateIdleState(const float DeltaTime)
+{
+	// Idle while standing still on the ground with nothing to animate, including turning in place
+	const bool bCanIdle = MovementState == EALSMovementState::Grounded && MovementAction == EALSMovementAction::None &&
+		!bIsMoving && !bHasMovementInput && AimYawRate <= 1.0f && MainAnimInstance &&
+		!MainAnimInstance->IsAnyMontagePlaying() && FMath::Abs(MainAnimInstance->GetCurveValues().RotationAmount) <= 0.001f;
+	if (!bCanIdle)
+	{
+		WakeFromIdle();
+		return;
+	}
+
+	IdleTime += DeltaTime;
+	if (bIdle || IdleTime < UALS_Settings::Get()->IdleDelay) { return; }
+
+	bIdle = true;
+	INC_DWORD_STAT(STAT_ALS_IdleCharacters);
+
+	// Batched characters ignore their actor tick interval, the batched tick holds them back instead
+	const float IdleTickInterval = UALS_Settings::Get()->IdleTickInterval;
+	if (BatchedTickIndex == INDEX_NONE)
+	{
+		ActiveActorTickInterval = PrimaryActorTick.TickInterval;
+		PrimaryActorTick.UpdateTickIntervalAndCoolDown(IdleTickInterval);
+	}
+	ActiveMeshTickInterval = GetMesh()->PrimaryComponentTick.TickInterval;
+	GetMesh()->PrimaryComponentTick.UpdateTickIntervalAndCoolDown(IdleTickInterval);
+}
+
+bool AALSBaseCharacter::ShouldWakeFromIdle() const
+{
+	if (!GetVelocity().IsNearlyZero() || !GetCharacterMovement()->GetCurrentAcceleration().IsNearlyZero())
+	{
+		return true;
+	}
+
+	// Looking around turns the character in place. Simulated proxies get the control rotation replicated.
+	return GetLocalRole() != ROLE_SimulatedProxy && !GetControlRotation().Equals(AimingRotation, 1.0f);
+}
+
+void AALSBaseCharacter::WakeFromIdle()
+{
+	IdleTime = 0.0f;
+	if (!bIdle) { return; }
+
+	bIdle = false;
+	DEC_DWORD_STAT(STAT_ALS_IdleCharacters);
+
+	// Also overwrites the current cooldown, so that the next tick isn't held back by the idle interval
+	if (BatchedTickIndex == INDEX_NONE) { PrimaryActorTick.UpdateTickIntervalAndCoolDown(ActiveActorTickInterval); }
+	GetMesh()->PrimaryComponentTick.UpdateTickIntervalAndCoolDown(ActiveMeshTickInterval);
+}
+
+void AALSBaseCharacter::OnAnimMontageStarted(UAnimMontage* Montage)
+{
+	WakeFromIdle();
+}
+
+void AALSBaseCharacter::EvaluateLocomotionFrame(const float DeltaTime)
+{
+	// Step 1: Set the essential values, the tick skips them for this frame.
+	SetEssentialValues(DeltaTime);
+
+	LocomotionFrame.FrameCounter = GFrameCounter;
+	LocomotionFrame.DeltaSeconds = DeltaTime;
+	LocomotionFrame.MovementState = MovementState;
+	LocomotionFrame.MovementAction = MovementAction;
+	LocomotionFrame.RotationMode = RotationMode;
+	LocomotionFrame.Stance = Stance;
+	LocomotionFrame.DesiredGait = DesiredGait;
+	LocomotionFrame.bHasMovementValues = false;
+	LocomotionFrame.bHasRotationValues = false;
+
+	const bool bGrounded = MovementState == EALSMovementState::Grounded && Stance != EALSStance::Riding;
+	if (!bGrounded && MovementState != EALSMovementState::Flight && MovementState != EALSMovementState::Swimming)
+	{
+		return;
+	}
+
+	// Step 2: Evaluate the gaits of UpdateCharacterMovement, with the movement settings of the last update.
+	LocomotionFrame.AllowedGait = GetAllowedGait();
+	LocomotionFrame.ActualGait = GetActualGait(LocomotionFrame.AllowedGait);
+	LocomotionFrame.bHasMovementValues = true;
+
+	if (!bGrounded || MovementAction != EALSMovementAction::None) { return; }
+
+	// Step 3: Evaluate the moving rotation of UpdateGroundedRotation, with the movement settings UpdateCharacterMovement
+	// is going to apply. The rotation itself is applied by the tick.
+	const FALSMovementModelEntry& FrameMovementEntry = *TargetMovementEntry;
+	LocomotionFrame.MappedSpeed = GetMappedSpeed(FrameMovementEntry.Settings);
+	const float CurveVal = UALSCurveCacheSubsystem::GetFloatValue(FrameMovementEntry.Settings.RotationRateCurve,
+																  FrameMovementEntry.BakedRotationRateCurve,
+																  LocomotionFrame.MappedSpeed);
+	const float ClampedAimYawRate = FMath::GetMappedRangeValueClamped({0.0f, 300.0f}, {1.0f, 3.0f}, AimYawRate);
+	LocomotionFrame.GroundedRotationRate = CurveVal * ClampedAimYawRate;
+	LocomotionFrame.RotationTarget = GetGroundedRotationTarget(LocomotionFrame.ActualGait,
+															   LocomotionFrame.GroundedRotationRate);
+	LocomotionFrame.bHasRotationValues = true;
+}
+
+bool AALSBaseCharacter::CanUseLocomotionFrame(const float DeltaTime) const
+{
+	return HasLocomotionFrame(DeltaTime) && LocomotionFrame.bHasMovementValues &&
+		LocomotionFrame.MovementState == MovementState && LocomotionFrame.MovementAction == MovementAction &&
+		LocomotionFrame.RotationMode == RotationMode && LocomotionFrame.Stance == Stance &&
+		LocomotionFrame.DesiredGait == DesiredGait;
+}
+
 void AALSBaseCharacter::UpdateCharacterMovement(const float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_UpdateCharacterMovement);
+	CSV_SCOPED_TIMING_STAT(ALS, UpdateCharacterMovement);
+
+	// The batched tick may have evaluated the gaits already, in its parallel phase
+	const bool bUseLocomotionFrame = CanUseLocomotionFrame(DeltaTime);
+
 	// Set the Allowed Gait
-	const EALSGait AllowedGait = GetAllowedGait();
+	const EALSGait AllowedGait = bUseLocomotionFrame ? LocomotionFrame.AllowedGait : GetAllowedGait();
 
 	// Determine the Actual Gait. If it is different from the current Gait, Set the new Gait Event.
-	const EALSGait ActualGait = GetActualGait(AllowedGait);
+	const EALSGait ActualGait = bUseLocomotionFrame ? LocomotionFrame.ActualGait : GetActualGait(AllowedGait);
 
 	if (ActualGait != Gait) { SetGait(ActualGait); }
 
@@ -889,6 +1346,9 @@ float AALSBaseCharacter::AdjustNewSwimmingSpeed(const float DeltaTime, const flo
 
 void AALSBaseCharacter::UpdateFlightMovement(const float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_UpdateFlightMovement);
+	CSV_SCOPED_TIMING_STAT(ALS, UpdateFlightMovement);
+
 	if (AlwaysCheckFlightConditions)
 	{
 		if (!CanFly())
@@ -901,8 +1361,6 @@ void AALSBaseCharacter::UpdateFlightMovement(const float DeltaTime)
 	// The rest of this function calculates the auto-hover strength. This is how much downward force is generated by
 	// the wings to keep the character afloat.
 
-	float AutoHover;
-
 	// Represents the strength of the wings forcing downward when flying, measured in the units below the character that
 	// the pressure gradient extends.
 	const float WingPressureDepth = FlightStrengthPassive / EffectiveWeight;
@@ -928,22 +1386,10 @@ void AALSBaseCharacter::UpdateFlightMovement(const float DeltaTime)
 
 	// @TODO Design an algorithm for calculating thrust, and use it to determine lift. modify auto-thrust with that so that the player slowly drifts down when too heavy.
 
-	switch (FlightMode)
-	{
-	case EALSFlightMode::None: return;
-	case EALSFlightMode::Neutral: AutoHover = (GroundPressure + 0.5) / 1.5 * LocalTemperatureAffect * LocalWeightAffect;
-		break;
-	case EALSFlightMode::Raising: AutoHover = (GroundPressure + FlightStrengthActive) * LocalTemperatureAffect * (
-			LocalWeightAffect * 1.5);
-		break;
-	case EALSFlightMode::Lowering: AutoHover = (GroundPressure * 0.5f) + (-FlightStrengthActive + (LocalTemperatureAffect
-			- 1)) + -LocalWeightAffect;
-		break;
-	case EALSFlightMode::Hovering: AutoHover = (GroundPressure + 0.5) / 1.5 * LocalTemperatureAffect * (
-			LocalWeightAffect / 2);
-		break;
-	default: return;
-	}
+	if (FlightMode == EALSFlightMode::None) { return; }
+	const float AutoHover = FALSLocomotionCore::CalculateAutoHover(ALSLocomotionCore::ToCore(FlightMode), GroundPressure,
+																   FlightStrengthActive, LocalTemperatureAffect,
+																   LocalWeightAffect);
 
 	const FRotator DirRotator(0.0f, AimingRotation.Yaw, 0.0f);
 	AddMovementInput(UKismetMathLibrary::GetUpVector(DirRotator), AutoHover, true);
@@ -951,47 +1397,88 @@ void AALSBaseCharacter::UpdateFlightMovement(const float DeltaTime)
 
 void AALSBaseCharacter::UpdateDynamicMovementSettingsStandalone(const float DeltaTime, const EALSGait AllowedGait)
 {
-	// Get the Current Movement Settings.
-	CurrentMovementSettings = GetTargetMovementSettings();
+	// Get the Current Movement Settings. Only copied when the state changed.
+	ApplyTargetMovementSettings();
 	const float NewMaxSpeed = CurrentMovementSettings.GetSpeedForGait(AllowedGait);
 
 	// Update the Acceleration, Deceleration, and Ground Friction using the Movement Curve.
-	const float MappedSpeed = GetMappedSpeed();
-	const FVector CurveVec = CurrentMovementSettings.MovementCurve->GetVectorValue(MappedSpeed);
+	FVector CurveVec;
+	const bool bWriteCurve = EvaluateMovementCurve(CurveVec);
+
+	// With change driven movement settings, max speeds are only sent when the gait, temperature, weight or incline
+	// changed the adjusted speed.
+	const bool bChangeDriven = UALS_Settings::Get()->bUseChangeDrivenMovementSettings;
+	int32 SkippedWrites = 0;
 
 	const auto CurrentMode = GetCharacterMovement()->MovementMode;
 	if (CurrentMode == MOVE_Walking || CurrentMode == MOVE_NavWalking)
 	{
 		// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
-		MyCharacterMovementComponent->SetMaxWalkingSpeed(AdjustNewWalkingSpeed(DeltaTime, NewMaxSpeed));
-		GetCharacterMovement()->MaxAcceleration = CurveVec.X;
-		GetCharacterMovement()->BrakingDecelerationWalking = CurveVec.Y;
-		GetCharacterMovement()->GroundFriction = CurveVec.Z;
+		const float NewWalkSpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewWalkingSpeed(DeltaTime, NewMaxSpeed));
+		if (!bChangeDriven || MyCharacterMovementComponent->MyNewMaxWalkSpeed != NewWalkSpeed)
+		{
+			MyCharacterMovementComponent->SetMaxWalkingSpeed(NewWalkSpeed);
+		}
+		else { SkippedWrites++; }
+
+		if (bWriteCurve)
+		{
+			GetCharacterMovement()->MaxAcceleration = CurveVec.X;
+			GetCharacterMovement()->BrakingDecelerationWalking = CurveVec.Y;
+			GetCharacterMovement()->GroundFriction = CurveVec.Z;
+		}
+		else { SkippedWrites += 3; }
 	}
 	else if (CurrentMode == MOVE_Flying)
 	{
-		MyCharacterMovementComponent->SetMaxFlyingSpeed(AdjustNewFlyingSpeed(DeltaTime, NewMaxSpeed));
-		GetCharacterMovement()->MaxAcceleration = CurveVec.X;
-		GetCharacterMovement()->BrakingDecelerationFlying = CurveVec.Y;
+		const float NewFlySpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewFlyingSpeed(DeltaTime, NewMaxSpeed));
+		if (!bChangeDriven || MyCharacterMovementComponent->MyNewMaxFlySpeed != NewFlySpeed)
+		{
+			MyCharacterMovementComponent->SetMaxFlyingSpeed(NewFlySpeed);
+		}
+		else { SkippedWrites++; }
+
+		if (bWriteCurve)
+		{
+			GetCharacterMovement()->MaxAcceleration = CurveVec.X;
+			GetCharacterMovement()->BrakingDecelerationFlying = CurveVec.Y;
+		}
+		else { SkippedWrites += 2; }
 	}
 	else if (CurrentMode == MOVE_Swimming)
 	{
-		MyCharacterMovementComponent->SetMaxSwimmingSpeed(AdjustNewSwimmingSpeed(DeltaTime, NewMaxSpeed));
-		GetCharacterMovement()->MaxAcceleration = CurveVec.X;
-		GetCharacterMovement()->BrakingDecelerationSwimming = CurveVec.Y;
+		const float NewSwimSpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewSwimmingSpeed(DeltaTime, NewMaxSpeed));
+		if (!bChangeDriven || MyCharacterMovementComponent->MyNewMaxSwimSpeed != NewSwimSpeed)
+		{
+			MyCharacterMovementComponent->SetMaxSwimmingSpeed(NewSwimSpeed);
+		}
+		else { SkippedWrites++; }
+
+		if (bWriteCurve)
+		{
+			GetCharacterMovement()->MaxAcceleration = CurveVec.X;
+			GetCharacterMovement()->BrakingDecelerationSwimming = CurveVec.Y;
+		}
+		else { SkippedWrites += 2; }
 	}
+
+	if (SkippedWrites > 0) { FALSStats::CountSkippedMovementSettingsWrites(SkippedWrites); }
 }
 
 void AALSBaseCharacter::UpdateDynamicMovementSettingsNetworked(const float DeltaTime, const EALSGait AllowedGait)
 {
-	// Get the Current Movement Settings.
-	CurrentMovementSettings = GetTargetMovementSettings();
+	// Get the Current Movement Settings. Only copied when the state changed.
+	ApplyTargetMovementSettings();
 	const float NewMaxSpeed = CurrentMovementSettings.GetSpeedForGait(AllowedGait);
 
 	const auto CurrentMode = GetCharacterMovement()->MovementMode;
 	if (CurrentMode == MOVE_Walking || CurrentMode == MOVE_NavWalking)
 	{
-		const float NewWalkSpeed = AdjustNewWalkingSpeed(DeltaTime, NewMaxSpeed);
+		const float NewWalkSpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewWalkingSpeed(DeltaTime, NewMaxSpeed));
 		// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
 		if (IsLocallyControlled() || HasAuthority())
 		{
@@ -1004,7 +1491,8 @@ void AALSBaseCharacter::UpdateDynamicMovementSettingsNetworked(const float Delta
 	}
 	else if (CurrentMode == MOVE_Flying)
 	{
-		const float NewFlySpeed = AdjustNewFlyingSpeed(DeltaTime, NewMaxSpeed);
+		const float NewFlySpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewFlyingSpeed(DeltaTime, NewMaxSpeed));
 		// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
 		if (IsLocallyControlled() || HasAuthority())
 		{
@@ -1017,7 +1505,8 @@ void AALSBaseCharacter::UpdateDynamicMovementSettingsNetworked(const float Delta
 	}
 	else if (CurrentMode == MOVE_Swimming)
 	{
-		const float NewSwimSpeed = AdjustNewSwimmingSpeed(DeltaTime, NewMaxSpeed);
+		const float NewSwimSpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewSwimmingSpeed(DeltaTime, NewMaxSpeed));
 		// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
 		if (IsLocallyControlled() || HasAuthority())
 		{
@@ -1032,18 +1521,19 @@ void AALSBaseCharacter::UpdateDynamicMovementSettingsNetworked(const float Delta
 
 void AALSBaseCharacter::UpdateDynamicMovementSettingsFull(const float DeltaTime, const EALSGait AllowedGait)
 {
-	// Get the Current Movement Settings.
-	CurrentMovementSettings = GetTargetMovementSettings();
+	// Get the Current Movement Settings. Only copied when the state changed.
+	ApplyTargetMovementSettings();
 	const float NewMaxSpeed = CurrentMovementSettings.GetSpeedForGait(AllowedGait);
 
-	// Update the Acceleration, Deceleration, and Ground Friction using the Movement Curve.
-	const float MappedSpeed = GetMappedSpeed();
-	const FVector CurveVec = CurrentMovementSettings.MovementCurve->GetVectorValue(MappedSpeed);
+	// The Acceleration, Deceleration, and Ground Friction are updated using the Movement Curve along with the speed.
+	FVector CurveVec;
+	int32 SkippedWrites = 0;
 
 	const auto CurrentMode = GetCharacterMovement()->MovementMode;
 	if (CurrentMode == MOVE_Walking || CurrentMode == MOVE_NavWalking)
 	{
-		const float NewWalkSpeed = AdjustNewWalkingSpeed(DeltaTime, NewMaxSpeed);
+		const float NewWalkSpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewWalkingSpeed(DeltaTime, NewMaxSpeed));
 
 		// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
 		if (IsLocallyControlled() || HasAuthority())
@@ -1051,16 +1541,21 @@ void AALSBaseCharacter::UpdateDynamicMovementSettingsFull(const float DeltaTime,
 			if (GetCharacterMovement()->MaxWalkSpeed != NewWalkSpeed)
 			{
 				MyCharacterMovementComponent->SetMaxWalkingSpeed(NewWalkSpeed);
-				GetCharacterMovement()->MaxAcceleration = CurveVec.X;
-				GetCharacterMovement()->BrakingDecelerationWalking = CurveVec.Y;
-				GetCharacterMovement()->GroundFriction = CurveVec.Z;
+				if (EvaluateMovementCurve(CurveVec))
+				{
+					GetCharacterMovement()->MaxAcceleration = CurveVec.X;
+					GetCharacterMovement()->BrakingDecelerationWalking = CurveVec.Y;
+					GetCharacterMovement()->GroundFriction = CurveVec.Z;
+				}
+				else { SkippedWrites += 3; }
 			}
 		}
 		else { GetCharacterMovement()->MaxWalkSpeed = NewWalkSpeed; }
 	}
 	else if (CurrentMode == MOVE_Flying)
 	{
-		const float NewFlySpeed = AdjustNewFlyingSpeed(DeltaTime, NewMaxSpeed);
+		const float NewFlySpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewFlyingSpeed(DeltaTime, NewMaxSpeed));
 
 		// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
 		if (IsLocallyControlled() || HasAuthority())
@@ -1068,15 +1563,20 @@ void AALSBaseCharacter::UpdateDynamicMovementSettingsFull(const float DeltaTime,
 			if (GetCharacterMovement()->MaxFlySpeed != NewFlySpeed)
 			{
 				MyCharacterMovementComponent->SetMaxFlyingSpeed(NewFlySpeed);
-				GetCharacterMovement()->MaxAcceleration = CurveVec.X;
-				GetCharacterMovement()->BrakingDecelerationFlying = CurveVec.Y;
+				if (EvaluateMovementCurve(CurveVec))
+				{
+					GetCharacterMovement()->MaxAcceleration = CurveVec.X;
+					GetCharacterMovement()->BrakingDecelerationFlying = CurveVec.Y;
+				}
+				else { SkippedWrites += 2; }
 			}
 		}
 		else { GetCharacterMovement()->MaxFlySpeed = NewFlySpeed; }
 	}
 	else if (CurrentMode == MOVE_Swimming)
 	{
-		const float NewSwimSpeed = AdjustNewSwimmingSpeed(DeltaTime, NewMaxSpeed);
+		const float NewSwimSpeed =
+			UALSCharacterMovementComponent::QuantizeMaxSpeed(AdjustNewSwimmingSpeed(DeltaTime, NewMaxSpeed));
 
 		// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
 		if (IsLocallyControlled() || HasAuthority())
@@ -1084,12 +1584,18 @@ void AALSBaseCharacter::UpdateDynamicMovementSettingsFull(const float DeltaTime,
 			if (GetCharacterMovement()->MaxSwimSpeed != NewSwimSpeed)
 			{
 				MyCharacterMovementComponent->SetMaxSwimmingSpeed(NewSwimSpeed);
-				GetCharacterMovement()->MaxAcceleration = CurveVec.X;
-				GetCharacterMovement()->BrakingDecelerationSwimming = CurveVec.Y;
+				if (EvaluateMovementCurve(CurveVec))
+				{
+					GetCharacterMovement()->MaxAcceleration = CurveVec.X;
+					GetCharacterMovement()->BrakingDecelerationSwimming = CurveVec.Y;
+				}
+				else { SkippedWrites += 2; }
 			}
 		}
 		else { GetCharacterMovement()->MaxSwimSpeed = NewSwimSpeed; }
 	}
+
+	if (SkippedWrites > 0) { FALSStats::CountSkippedMovementSettingsWrites(SkippedWrites); }
 }
 
 void AALSBaseCharacter::UpdateGroundedRotation(const float DeltaTime)
@@ -1099,33 +1605,20 @@ void AALSBaseCharacter::UpdateGroundedRotation(const float DeltaTime)
 		const bool bCanUpdateMovingRot = ((bIsMoving && bHasMovementInput) || Speed > 150.0f) && !HasAnyRootMotion();
 		if (bCanUpdateMovingRot)
 		{
-			const float GroundedRotationRate = CalculateGroundedRotationRate();
-			if (RotationMode == EALSRotationMode::VelocityDirection)
+			// The batched tick may have evaluated the target already, in its parallel phase
+			const bool bUseLocomotionFrame = CanUseLocomotionFrame(DeltaTime) && LocomotionFrame.bHasRotationValues &&
+				LocomotionFrame.ActualGait == Gait;
+			FALSGroundedRotationTarget Target;
+			if (bUseLocomotionFrame) { Target = LocomotionFrame.RotationTarget; }
+			else { Target = GetGroundedRotationTarget(Gait, CalculateGroundedRotationRate()); }
+
+			if (Target.bValid)
 			{
-				// Velocity Direction Rotation
-				SmoothCharacterRotation({0.0f, LastVelocityRotation.Yaw, 0.0f},
-										800.0f,
-										GroundedRotationRate,
+				float YawValue = Target.Yaw;
+				if (Target.bAddYawOffsetCurve) { YawValue += MainAnimInstance->GetCurveValue(FName(TEXT("YawOffset"))); }
+				SmoothCharacterRotation({0.0f, YawValue, 0.0f}, Target.TargetInterpSpeed, Target.ActorInterpSpeed,
 										DeltaTime);
 			}
-			else if (RotationMode == EALSRotationMode::LookingDirection)
-			{
-				// Looking Direction Rotation
-				float YawValue;
-				if (Gait == EALSGait::GaitFast) { YawValue = LastVelocityRotation.Yaw; }
-				else
-				{
-					// Walking or Running..
-					const float YawOffsetCurveVal = MainAnimInstance->GetCurveValue(FName(TEXT("YawOffset")));
-					YawValue = AimingRotation.Yaw + YawOffsetCurveVal;
-				}
-				SmoothCharacterRotation({0.0f, YawValue, 0.0f}, 500.0f, GroundedRotationRate, DeltaTime);
-			}
-			else if (RotationMode == EALSRotationMode::Aiming)
-			{
-				const float ControlYaw = AimingRotation.Yaw;
-				SmoothCharacterRotation({0.0f, ControlYaw, 0.0f}, 1000.0f, 20.0f, DeltaTime);
-			}
 		}
 		else
 		{
@@ -1254,8 +1747,11 @@ void AALSBaseCharacter::MantleStart(const float MantleHeight, const FALSComponen
 															  MantleHeight);
 
 	// Step 2: Convert the world space target to the mantle component's local space for use in moving objects.
+	// Ledges that couldn't be resolved over the network have no component, their target stays in world space.
 	MantleLedgeLS.Component = MantleLedgeWS.Component;
-	MantleLedgeLS.Transform = MantleLedgeWS.Transform * MantleLedgeWS.Component->GetComponentToWorld().Inverse();
+	MantleLedgeLS.Transform = MantleLedgeWS.Component
+								  ? MantleLedgeWS.Transform * MantleLedgeWS.Component->GetComponentToWorld().Inverse()
+								  : MantleLedgeWS.Transform;
 
 	// Step 3: Set the Mantle Target and calculate the Starting Offset
 	// (offset amount between the actor and target transform).
@@ -1271,19 +1767,16 @@ void AALSBaseCharacter::MantleStart(const float MantleHeight, const FALSComponen
 								 FVector::OneVector);
 	MantleAnimatedStartOffset = UALSMathLibrary::TransfromSub(StartOffset, MantleTarget);
 
-	// Step 5: Clear the Character Movement Mode and set the Movement State to Mantling
-	GetCharacterMovement()->SetMovementMode(MOVE_None);
-	SetMovementState(EALSMovementState::Mantling);
-
-	// Step 6: Configure the Mantle Timeline so that it is the same length as the
-	// Lerp/Correction curve minus the starting position, and plays at the same speed as the animation.
-	// Then start the timeline.
+	// Step 5: Set the mantle length to the length of the Lerp/Correction curve minus the starting position.
+	// The movement component plays it at the same speed as the animation.
 	float MinTime = 0.0f;
 	float MaxTime = 0.0f;
 	MantleParams.PositionCorrectionCurve->GetTimeRange(MinTime, MaxTime);
-	MantleTimeline->SetTimelineLength(MaxTime - MantleParams.StartingPosition);
-	MantleTimeline->SetPlayRate(MantleParams.PlayRate);
-	MantleTimeline->PlayFromStart();
+	MantleLength = MaxTime - MantleParams.StartingPosition;
+
+	// Step 6: Switch the movement component to the mantle movement mode and set the Movement State to Mantling
+	MyCharacterMovementComponent->StartMantle();
+	SetMovementState(EALSMovementState::Mantling);
 
 	// Step 7: Play the Anim Montage if valid.
 	if (IsValid(MantleParams.AnimMontage))
@@ -1298,6 +1791,9 @@ void AALSBaseCharacter::MantleStart(const float MantleHeight, const FALSComponen
 
 bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_MantleCheck);
+	CSV_SCOPED_TIMING_STAT(ALS, MantleCheck);
+
 	// Step 1: Trace forward to find a wall / object the character cannot walk on.
 	const FVector& CapsuleBaseLocation = UALSMathLibrary::GetCapsuleBaseLocation(2.0f, GetCapsuleComponent());
 	FVector TraceStart = CapsuleBaseLocation + GetMovementDirection() * -30.0f;
@@ -1317,6 +1813,7 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 #endif
 
 	FHitResult HitResult;
+	FALSStats::CountSceneQuery();
 	World->SweepSingleByChannel(HitResult,
 								TraceStart,
 								TraceEnd,
@@ -1352,6 +1849,7 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 	if (DrawDebug) DrawDebugLine(World, DownwardTraceStart, DownwardTraceEnd, FColor::Blue, false, 1.f, 0, 3);
 #endif
 
+	FALSStats::CountSceneQuery();
 	World->SweepSingleByChannel(HitResult,
 								DownwardTraceStart,
 								DownwardTraceEnd,
@@ -1393,21 +1891,33 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 	FALSComponentAndTransform MantleWS;
 	MantleWS.Component = HitComponent;
 	MantleWS.Transform = TargetTransform;
-	MantleStart(MantleHeight, MantleWS, MantleType);
-	Server_MantleStart(MantleHeight, MantleWS, MantleType);
+	if (HasAuthority())
+	{
+		MantleStart(MantleHeight, MantleWS, MantleType);
+		Multicast_MantleStart(MantleHeight, MantleWS, MantleType);
+	}
+	else
+	{
+		// Predict the mantle, the server validates it when it gets the move that started it.
+		// Use the target as it's sent, so that both sides play the same mantle.
+		MantleWS.Transform = UALSCharacterMovementComponent::QuantizeMantleTarget(TargetTransform);
+		MantleStart(MantleHeight, MantleWS, MantleType);
+		MyCharacterMovementComponent->RequestMantle(MantleHeight, MantleWS, MantleType);
+	}
 
 	return true;
 }
 
-// This function is called by "MantleTimeline" using BindUFunction in the AALSBaseCharacter::BeginPlay during the default settings initialization.
-void AALSBaseCharacter::MantleUpdate(const float BlendIn)
+FTransform AALSBaseCharacter::MantleUpdate(const float PlaybackPosition)
 {
 	// Step 1: Continually update the mantle target from the stored local transform to follow along with moving objects
-	MantleTarget = UALSMathLibrary::MantleComponentLocalToWorld(MantleLedgeLS);
+	MantleTarget = MantleLedgeLS.Component
+					   ? UALSMathLibrary::MantleComponentLocalToWorld(MantleLedgeLS)
+					   : MantleLedgeLS.Transform;
 
 	// Step 2: Update the Position and Correction Alphas using the Position/Correction curve set for each Mantle.
 	const FVector CurveVec = MantleParams.PositionCorrectionCurve->GetVectorValue(
-		MantleParams.StartingPosition + MantleTimeline->GetPlaybackPosition());
+		MantleParams.StartingPosition + PlaybackPosition);
 	const float PositionAlpha = CurveVec.X;
 	const float XYCorrectionAlpha = CurveVec.Y;
 	const float ZCorrectionAlpha = CurveVec.Z;
@@ -1448,13 +1958,15 @@ void AALSBaseCharacter::MantleUpdate(const float BlendIn)
 
 	// Initial Blend In (controlled in the timeline curve) to allow the actor to blend into the Position/Correction
 	// curve at the midpoint. This prevents pops when mantling an object lower than the animated mantle.
+	const float BlendIn = MantleTimelineCurve ? MantleTimelineCurve->GetFloatValue(PlaybackPosition) : 1.0f;
 	const FTransform& LerpedTarget = UKismetMathLibrary::TLerp(
 		UALSMathLibrary::TransfromAdd(MantleTarget, MantleActualStartOffset),
 		ResultLerp,
 		BlendIn);
 
-	// Step 4: Set the actors location and rotation to the lerped Target.
-	SetActorLocationAndTargetRotation(LerpedTarget.GetLocation(), LerpedTarget.GetRotation().Rotator());
+	// Step 4: Return the lerped Target, the movement component moves the actor there.
+	TargetRotation = LerpedTarget.Rotator();
+	return LerpedTarget;
 }
 
 void AALSBaseCharacter::MantleEnd()
@@ -1463,27 +1975,107 @@ void AALSBaseCharacter::MantleEnd()
 	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
 }
 
-float AALSBaseCharacter::GetMappedSpeed() const
+void AALSBaseCharacter::StartPredictedMantle(const float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
+											 const EALSMantleType MantleType)
 {
-	// Map the character's current speed to the configured movement speeds with a range of 0-3,
-	// with 0 = stopped, 1 = the Slow Speed, 2 = the Normal Speed, and 3 = the Fast Speed.
-	// This allows us to vary the movement speeds but still use the mapped range in calculations for consistent results
+	if (!ValidateMantle(MantleHeight, MantleLedgeWS, MantleType))
+	{
+		// The client stops its mantle, the forced correction then moves it back to where the server has it
+		MyCharacterMovementComponent->ForceClientAdjustment();
+		Client_RejectMantle();
+		return;
+	}
 
-	const float LocSlowSpeed = CurrentMovementSettings.SlowSpeed;
-	const float LocNormalSpeed = CurrentMovementSettings.NormalSpeed;
-	const float LocFastSpeed = CurrentMovementSettings.FastSpeed;
+	MantleStart(MantleHeight, MantleLedgeWS, MantleType);
+	Multicast_MantleStart(MantleHeight, MantleLedgeWS, MantleType);
+}
 
-	if (Speed > LocNormalSpeed)
+bool AALSBaseCharacter::ValidateMantle(const float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
+									   const EALSMantleType MantleType)
+{
+	// Step 1: The character has to be in a state it can mantle from.
+	if (MovementState != EALSMovementState::Grounded && MovementState != EALSMovementState::Freefall) { return false; }
+
+	// Step 2: The ledge has to be in reach of the mantle traces from where the server has the character,
+	// and the mantle height has to match it.
+	const float Tolerance = UALS_Settings::Get()->MantleValidationTolerance;
+	const float MaxReach = FMath::Max3(GroundedTraceSettings.ReachDistance, AutomaticTraceSettings.ReachDistance,
+									   FallingTraceSettings.ReachDistance);
+	const float MaxLedgeHeight = FMath::Max3(GroundedTraceSettings.MaxLedgeHeight, AutomaticTraceSettings.MaxLedgeHeight,
+											 FallingTraceSettings.MaxLedgeHeight);
+	const FVector Offset = MantleLedgeWS.Transform.GetLocation() - GetActorLocation();
+	if (Offset.Size2D() > MaxReach + GetCapsuleComponent()->GetScaledCapsuleRadius() + Tolerance
+		|| Offset.Z > MaxLedgeHeight + GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + Tolerance
+		|| FMath::Abs(Offset.Z - MantleHeight) > Tolerance)
 	{
-		return FMath::GetMappedRangeValueClamped({LocNormalSpeed, LocFastSpeed}, {2.0f, 3.0f}, Speed);
+		return false;
 	}
 
-	if (Speed > LocSlowSpeed)
+	// Step 3: The surface mustn't move too fast, as in MantleCheck.
+	if (MantleLedgeWS.Component && MantleLedgeWS.Component->GetComponentVelocity().Size() > AcceptableVelocityWhileMantling)
 	{
-		return FMath::GetMappedRangeValueClamped({LocSlowSpeed, LocNormalSpeed}, {1.0f, 2.0f}, Speed);
+		return false;
 	}
 
-	return FMath::GetMappedRangeValueClamped({0.0f, LocSlowSpeed}, {0.0f, 1.0f}, Speed);
+	// Step 4: There has to be a walkable surface under the target, as found by the downward trace of MantleCheck.
+	// The target is the capsule location above it, so the surface is expected at the capsule base.
+	UWorld* World = GetWorld();
+	check(World);
+
+	FCollisionQueryParams Params;
+	Params.AddIgnoredActor(this);
+
+	const float DownwardTraceRadius = FMath::Max3(GroundedTraceSettings.DownwardTraceRadius,
+												  AutomaticTraceSettings.DownwardTraceRadius,
+												  FallingTraceSettings.DownwardTraceRadius);
+	const FVector LedgeBase = MantleLedgeWS.Transform.GetLocation() -
+		FVector(0.0f, 0.0f, GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + 2.0f);
+	const FVector DownwardTraceStart = LedgeBase + FVector(0.0f, 0.0f, Tolerance + DownwardTraceRadius + 1.0f);
+	const FVector DownwardTraceEnd = LedgeBase - FVector(0.0f, 0.0f, Tolerance);
+
+	FHitResult HitResult;
+	FALSStats::CountSceneQuery();
+	World->SweepSingleByChannel(HitResult,
+								DownwardTraceStart,
+								DownwardTraceEnd,
+								FQuat::Identity,
+								UALS_Settings::Get()->MantleCheckChannel,
+								FCollisionShape::MakeSphere(DownwardTraceRadius),
+								Params);
+
+	if (!GetCharacterMovement()->IsWalkable(HitResult) || FMath::Abs(HitResult.ImpactPoint.Z - LedgeBase.Z) > Tolerance)
+	{
+		return false;
+	}
+
+	// Step 5: The capsule has to have room at the target, and gameplay has to allow the mantle.
+	return UALSMathLibrary::CapsuleHasRoomCheck(GetCapsuleComponent(), MantleLedgeWS.Transform.GetLocation(), 0.0f, 0.0f)
+		&& CanMantle(MantleType);
+}
+
+void AALSBaseCharacter::Client_RejectMantle_Implementation()
+{
+	// Drop the mantle from the saved moves, so that replaying them after the correction doesn't start it again
+	MyCharacterMovementComponent->RejectMantle();
+	if (MovementState != EALSMovementState::Mantling) { return; }
+
+	if (MainAnimInstance && MantleParams.AnimMontage) { MainAnimInstance->Montage_Stop(0.2f, MantleParams.AnimMontage); }
+	GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+}
+
+float AALSBaseCharacter::GetMappedSpeed() const
+{
+	return GetMappedSpeed(CurrentMovementSettings);
+}
+
+float AALSBaseCharacter::GetMappedSpeed(const FALSMovementSettings& MovementSettings) const
+{
+	// Map the character's current speed to the configured movement speeds with a range of 0-3,
+	// with 0 = stopped, 1 = the Slow Speed, 2 = the Normal Speed, and 3 = the Fast Speed.
+	// This allows us to vary the movement speeds but still use the mapped range in calculations for consistent results
+
+	return FALSLocomotionCore::GetMappedSpeed(
+		Speed, {MovementSettings.SlowSpeed, MovementSettings.NormalSpeed, MovementSettings.FastSpeed});
 }
 
 EALSGait AALSBaseCharacter::GetAllowedGait() const
@@ -1492,20 +2084,12 @@ EALSGait AALSBaseCharacter::GetAllowedGait() const
 	// and can be determined by the desired gait, the rotation mode, the stance, etc. For example,
 	// if you wanted to force the character into a walking state while indoors, this could be done here.
 
-	if (Stance == EALSStance::Standing)
-	{
-		if (RotationMode != EALSRotationMode::Aiming)
-		{
-			if (DesiredGait == EALSGait::GaitFast) { return CanSprint() ? EALSGait::GaitFast : EALSGait::GaitNormal; }
-			return DesiredGait;
-		}
-	}
-
-	// Crouching stance & Aiming rot mode has same behaviour
-
-	if (DesiredGait == EALSGait::GaitFast) { return EALSGait::GaitNormal; }
-
-	return DesiredGait;
+	// Only standing and not aiming allows sprinting, the sprint check is skipped otherwise.
+	const bool bCanSprint = DesiredGait == EALSGait::GaitFast && Stance == EALSStance::Standing &&
+		RotationMode != EALSRotationMode::Aiming && CanSprint();
+	return ALSLocomotionCore::FromCore(FALSLocomotionCore::GetAllowedGait(
+		ALSLocomotionCore::ToCore(Stance), ALSLocomotionCore::ToCore(RotationMode),
+		ALSLocomotionCore::ToCore(DesiredGait), bCanSprint));
 }
 
 EALSGait AALSBaseCharacter::GetActualGait(const EALSGait AllowedGait) const
@@ -1514,18 +2098,9 @@ EALSGait AALSBaseCharacter::GetActualGait(const EALSGait AllowedGait) const
 	// from the desired gait or allowed gait. For instance, if the Allowed Gait becomes walking,
 	// the Actual gait will still be running until the character decelerates to the walking speed.
 
-	const float LocWalkSpeed = CurrentMovementSettings.SlowSpeed;
-	const float LocRunSpeed = CurrentMovementSettings.NormalSpeed;
-
-	if (Speed > LocRunSpeed + 10.0f)
-	{
-		if (AllowedGait == EALSGait::GaitFast) { return EALSGait::GaitFast; }
-		return EALSGait::GaitNormal;
-	}
-
-	if (Speed >= LocWalkSpeed + 10.0f) { return EALSGait::GaitNormal; }
-
-	return EALSGait::GaitSlow;
+	return ALSLocomotionCore::FromCore(FALSLocomotionCore::GetActualGait(
+		Speed, {CurrentMovementSettings.SlowSpeed, CurrentMovementSettings.NormalSpeed, CurrentMovementSettings.FastSpeed},
+		ALSLocomotionCore::ToCore(AllowedGait)));
 }
 
 void AALSBaseCharacter::SmoothCharacterRotation(const FRotator Target, const float TargetInterpSpeed,
@@ -1543,11 +2118,49 @@ float AALSBaseCharacter::CalculateGroundedRotationRate() const
 	// rates for each speed. Increase the speed if the camera is rotating quickly for more responsive rotation.
 
 	const float MappedSpeedVal = GetMappedSpeed();
-	const float CurveVal = CurrentMovementSettings.RotationRateCurve->GetFloatValue(MappedSpeedVal);
+	const FALSBakedCurve* BakedCurve = AppliedMovementEntry ? AppliedMovementEntry->BakedRotationRateCurve : nullptr;
+	const float CurveVal = UALSCurveCacheSubsystem::GetFloatValue(CurrentMovementSettings.RotationRateCurve, BakedCurve,
+																  MappedSpeedVal);
 	const float ClampedAimYawRate = FMath::GetMappedRangeValueClamped({0.0f, 300.0f}, {1.0f, 3.0f}, AimYawRate);
 	return CurveVal * ClampedAimYawRate;
 }
 
+FALSGroundedRotationTarget AALSBaseCharacter::GetGroundedRotationTarget(const EALSGait CurrentGait,
+																		const float GroundedRotationRate) const
+{
+	FALSGroundedRotationTarget Target;
+	if (RotationMode == EALSRotationMode::VelocityDirection)
+	{
+		// Velocity Direction Rotation
+		Target.bValid = true;
+		Target.Yaw = LastVelocityRotation.Yaw;
+		Target.TargetInterpSpeed = 800.0f;
+		Target.ActorInterpSpeed = GroundedRotationRate;
+	}
+	else if (RotationMode == EALSRotationMode::LookingDirection)
+	{
+		// Looking Direction Rotation
+		Target.bValid = true;
+		if (CurrentGait == EALSGait::GaitFast) { Target.Yaw = LastVelocityRotation.Yaw; }
+		else
+		{
+			// Walking or Running..
+			Target.Yaw = AimingRotation.Yaw;
+			Target.bAddYawOffsetCurve = true;
+		}
+		Target.TargetInterpSpeed = 500.0f;
+		Target.ActorInterpSpeed = GroundedRotationRate;
+	}
+	else if (RotationMode == EALSRotationMode::Aiming)
+	{
+		Target.bValid = true;
+		Target.Yaw = AimingRotation.Yaw;
+		Target.TargetInterpSpeed = 1000.0f;
+		Target.ActorInterpSpeed = 20.0f;
+	}
+	return Target;
+}
+
 float AALSBaseCharacter::CalculateFlightRotationRate() const
 {
 	// Calculate the rotation rate by using the current Rotation Rate Curve in the Movement Settings.
@@ -1555,7 +2168,9 @@ float AALSBaseCharacter::CalculateFlightRotationRate() const
 	// rates for each speed. Increase the speed if the camera is rotating quickly for more responsive rotation.
 
 	const float MappedSpeedVal = GetMappedSpeed();
-	const float CurveVal = CurrentMovementSettings.RotationRateCurve->GetFloatValue(MappedSpeedVal);
+	const FALSBakedCurve* BakedCurve = AppliedMovementEntry ? AppliedMovementEntry->BakedRotationRateCurve : nullptr;
+	const float CurveVal = UALSCurveCacheSubsystem::GetFloatValue(CurrentMovementSettings.RotationRateCurve, BakedCurve,
+																  MappedSpeedVal);
 	const float ClampedAimYawRate = FMath::GetMappedRangeValueClamped({0.0f, 300.0f}, {1.0f, 3.0f}, AimYawRate);
 	return CurveVal * ClampedAimYawRate;
 }
@@ -1576,6 +2191,7 @@ float AALSBaseCharacter::FlightDistanceCheck(const float CheckDistance, const FV
 
 	const FVector CheckStart = GetActorLocation() - FVector{0, 0, GetCapsuleComponent()->GetScaledCapsuleHalfHeight()};
 	const FVector CheckEnd = CheckStart + (Direction * CheckDistance);
+	FALSStats::CountSceneQuery();
 	World->LineTraceSingleByChannel(HitResult, CheckStart, CheckEnd, UALS_Settings::Get()->FlightCheckChannel, Params);
 
 #if WITH_EDITOR
@@ -1607,19 +2223,108 @@ void AALSBaseCharacter::LimitRotation(const float AimYawMin, const float AimYawM
 void AALSBaseCharacter::SetTemperature(const float NewTemperature)
 {
 	Temperature = NewTemperature;
-	if (TemperatureAffectCurve) { TemperatureAffect = TemperatureAffectCurve->GetVectorValue(Temperature); }
+	if (TemperatureAffectCurve)
+	{
+		TemperatureAffect = CurveCache
+								? CurveCache->GetVectorValue(TemperatureAffectCurve, Temperature)
+								: TemperatureAffectCurve->GetVectorValue(Temperature);
+	}
 	else { TemperatureAffect = {1, 1, 1}; }
 }
 
 void AALSBaseCharacter::SetWeight(const float NewWeight)
 {
 	EffectiveWeight = NewWeight;
-	if (WeightAffectCurve) { WeightAffect = WeightAffectCurve->GetVectorValue(EffectiveWeight / WeightAffectScale); }
+	if (WeightAffectCurve)
+	{
+		WeightAffect = CurveCache
+						   ? CurveCache->GetVectorValue(WeightAffectCurve, EffectiveWeight / WeightAffectScale)
+						   : WeightAffectCurve->GetVectorValue(EffectiveWeight / WeightAffectScale);
+	}
 	else { WeightAffect = {1, 1, 1}; }
 }
 
 //**		VARIABLE REPLICATION		**//
 
+void AALSBaseCharacter::SyncReplicatedStates()
+{
+	ReplicatedStates.DesiredGait = DesiredGait;
+	ReplicatedStates.DesiredStance = DesiredStance;
+	ReplicatedStates.DesiredRotationMode = DesiredRotationMode;
+	ReplicatedStates.RotationMode = RotationMode;
+	ReplicatedStates.OverlayState = OverlayState;
+	ReplicatedStates.FlightMode = FlightMode;
+	// The mask only selects fields for Server_SetStates, the replicated property always sends all of them
+	ReplicatedStates.FieldMask = FALSReplicatedStates::AllFields;
+}
+
+void AALSBaseCharacter::OnRep_ReplicatedStates()
+{
+	DesiredGait = ReplicatedStates.DesiredGait;
+	DesiredStance = ReplicatedStates.DesiredStance;
+	DesiredRotationMode = ReplicatedStates.DesiredRotationMode;
+
+	if (RotationMode != ReplicatedStates.RotationMode)
+	{
+		const EALSRotationMode Prev = RotationMode;
+		RotationMode = ReplicatedStates.RotationMode;
+		OnRep_RotationMode(Prev);
+	}
+
+	if (OverlayState != ReplicatedStates.OverlayState)
+	{
+		const EALSOverlayState Prev = OverlayState;
+		OverlayState = ReplicatedStates.OverlayState;
+		OnRep_OverlayState(Prev);
+	}
+
+	if (FlightMode != ReplicatedStates.FlightMode)
+	{
+		const EALSFlightMode Prev = FlightMode;
+		FlightMode = ReplicatedStates.FlightMode;
+		OnRep_FlightMode(Prev);
+	}
+}
+
+void AALSBaseCharacter::UpdateReplicationBucket()
+{
+	const UNetDriver* NetDriver = GetNetDriver();
+	if (!NetDriver) { return; }
+
+	// Step 1: Find the nearest bucket over all connections
+	EALSReplicationBucket NearestBucket = EALSReplicationBucket::Far;
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection || !Connection->ViewTarget || !Connection->OwningActor) { continue; }
+
+		if (Connection->ViewTarget == this)
+		{
+			NearestBucket = EALSReplicationBucket::Near;
+			break;
+		}
+
+		const FNetViewer Viewer(Connection, 0.0f);
+		const EALSReplicationBucket Bucket = GetReplicationBucket(Viewer.ViewLocation);
+		if (Bucket < NearestBucket) { NearestBucket = Bucket; }
+		if (NearestBucket == EALSReplicationBucket::Near) { break; }
+	}
+
+	if (NearestBucket == ReplicationBucket) { return; }
+	ReplicationBucket = NearestBucket;
+
+	// Step 2: Replicate less often while nobody views the character from close by
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	switch (ReplicationBucket)
+	{
+	case EALSReplicationBucket::Mid: NetUpdateFrequency = FMath::Min(NearNetUpdateFrequency, Settings->MidNetUpdateFrequency);
+		break;
+	case EALSReplicationBucket::Far: NetUpdateFrequency = FMath::Min(NearNetUpdateFrequency, Settings->FarNetUpdateFrequency);
+		break;
+	default: NetUpdateFrequency = NearNetUpdateFrequency;
+		break;
+	}
+}
+
 void AALSBaseCharacter::OnRep_RotationMode(const EALSRotationMode PrevRotMode) { OnRotationModeChanged(PrevRotMode); }
 
 void AALSBaseCharacter::OnRep_FlightMode(const EALSFlightMode PrevFlightMode) { OnFlightModeChanged(PrevFlightMode); }
@@ -1657,68 +2362,94 @@ void AALSBaseCharacter::Server_SetMeshLocationDuringRagdoll_Implementation(const
 	TargetRagdollLocation = MeshLocation;
 }
 
-void AALSBaseCharacter::Server_SetDesiredStance_Implementation(const EALSStance NewStance)
+void AALSBaseCharacter::Server_SetRagdollSnapshot_Implementation(const FALSRagdollSnapshot& Snapshot)
 {
-	SetDesiredStance(NewStance);
+	ReceiveRagdollSnapshot(Snapshot);
+	ReplicatedRagdollSnapshot = Snapshot;
 }
 
-void AALSBaseCharacter::Server_SetDesiredGait_Implementation(const EALSGait NewGait) { SetDesiredGait(NewGait); }
-
-void AALSBaseCharacter::Server_SetDesiredRotationMode_Implementation(const EALSRotationMode NewRotMode)
+void AALSBaseCharacter::RequestServerStates(const uint8 Fields)
 {
-	SetDesiredRotationMode(NewRotMode);
-}
+	PendingServerStates.FieldMask |= Fields;
 
-void AALSBaseCharacter::Server_SetRotationMode_Implementation(const EALSRotationMode NewRotationMode)
-{
-	SetRotationMode(NewRotationMode);
+	// The request is sent at the end of the tick, don't let the idle tick rate hold it back
+	WakeFromIdle();
 }
 
-void AALSBaseCharacter::Server_SetFlightMode_Implementation(const EALSFlightMode NewFlightMode)
+void AALSBaseCharacter::Server_SetStates_Implementation(const FALSReplicatedStates& States)
 {
-	SetFlightMode(NewFlightMode);
-}
-
-void AALSBaseCharacter::Server_SetOverlayState_Implementation(const EALSOverlayState NewState)
-{
-	SetOverlayState(NewState);
+	const uint8 Fields = States.FieldMask;
+	if (Fields & FALSReplicatedStates::DesiredGaitField) { SetDesiredGait(States.DesiredGait); }
+	if (Fields & FALSReplicatedStates::DesiredStanceField) { SetDesiredStance(States.DesiredStance); }
+	if (Fields & FALSReplicatedStates::DesiredRotationModeField) { SetDesiredRotationMode(States.DesiredRotationMode); }
+	if (Fields & FALSReplicatedStates::RotationModeField) { SetRotationMode(States.RotationMode); }
+	if (Fields & FALSReplicatedStates::OverlayStateField) { SetOverlayState(States.OverlayState); }
+	if (Fields & FALSReplicatedStates::FlightModeField) { SetFlightMode(States.FlightMode); }
 }
 
 void AALSBaseCharacter::Multicast_OnLanded_Implementation() { if (!IsLocallyControlled()) { EventOnLanded(); } }
 
-void AALSBaseCharacter::Server_MantleStart_Implementation(const float MantleHeight,
-														  const FALSComponentAndTransform& MantleLedgeWS,
-														  const EALSMantleType MantleType)
-{
-	Multicast_MantleStart(MantleHeight, MantleLedgeWS, MantleType);
-}
-
 void AALSBaseCharacter::Multicast_MantleStart_Implementation(const float MantleHeight,
 															 const FALSComponentAndTransform& MantleLedgeWS,
 															 const EALSMantleType MantleType)
 {
-	if (!IsLocallyControlled()) { MantleStart(MantleHeight, MantleLedgeWS, MantleType); }
+	// The server and the owning client started it already
+	if (GetLocalRole() == ROLE_SimulatedProxy) { MantleStart(MantleHeight, MantleLedgeWS, MantleType); }
 }
 
 void AALSBaseCharacter::Server_PlayMontage_Implementation(UAnimMontage* Montage, const float Track)
 {
-	Multicast_PlayMontage(Montage, Track);
+	// Roll: Simply play a Root Motion Montage.
+	if (!IsLocallyControlled()) { MainAnimInstance->Montage_Play(Montage, Track); }
+
+	const UWorld* World = GetWorld();
+	check(World);
+	const AGameStateBase* GameState = World->GetGameState();
+
+	ReplicatedMontage.Montage = Montage;
+	ReplicatedMontage.StartTime = GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+	ReplicatedMontage.PlayRate = Track;
+	++ReplicatedMontage.Sequence;
 }
 
-void AALSBaseCharacter::Multicast_PlayMontage_Implementation(UAnimMontage* Montage, const float Track)
+void AALSBaseCharacter::OnRep_ReplicatedMontage()
 {
-	if (!IsLocallyControlled())
+	GetWorldTimerManager().ClearTimer(ReplicatedMontageRetryTimer);
+
+	UAnimMontage* Montage = ReplicatedMontage.Montage;
+	if (!Montage || !MainAnimInstance) { return; }
+
+	const UWorld* World = GetWorld();
+	check(World);
+
+	// Before the game state and its server world time replicated, the elapsed time is meaningless or negative.
+	// Try again next frame instead of starting the montage at a made up position.
+	const AGameStateBase* GameState = World->GetGameState();
+	const float Elapsed = GameState ? GameState->GetServerWorldTimeSeconds() - ReplicatedMontage.StartTime : -1.0f;
+	if (Elapsed < 0.0f)
 	{
-		// Roll: Simply play a Root Motion Montage.
-		MainAnimInstance->Montage_Play(Montage, Track);
+		ReplicatedMontageRetryTimer = GetWorldTimerManager().SetTimerForNextTick(
+			this, &AALSBaseCharacter::OnRep_ReplicatedMontage);
+		return;
 	}
+
+	// Late joiners and proxies that became relevant midway start where the server is, finished montages are skipped
+	const float Position = Elapsed * ReplicatedMontage.PlayRate;
+	if (Position >= Montage->GetPlayLength()) { return; }
+
+	MainAnimInstance->Montage_Play(Montage, ReplicatedMontage.PlayRate, EMontagePlayReturnType::MontageLength, Position);
+	WakeFromIdle();
 }
 
 void AALSBaseCharacter::OnJumped_Implementation()
 {
 	Super::OnJumped_Implementation();
 	if (IsLocallyControlled()) { EventOnJumped(); }
-	if (HasAuthority()) { Multicast_OnJumped(); }
+	if (HasAuthority())
+	{
+		TGuardValue<bool> CosmeticEventGuard(bSendingCosmeticEvent, UALS_Settings::Get()->bUseReplicationBuckets);
+		Multicast_OnJumped();
+	}
 }
 
 void AALSBaseCharacter::Multicast_OnJumped_Implementation() { if (!IsLocallyControlled()) { EventOnJumped(); } }
@@ -10,6 +10,7 @@
 UALSCharacterMovementComponent::UALSCharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	SetNetworkMoveDataContainer(ALSNetworkMoveDataContainer);
 }
 
 void UALSCharacterMovementComponent::OnMovementUpdated(const float DeltaTime, const FVector& OldLocation,
@@ -29,6 +30,16 @@ void UALSCharacterMovementComponent::OnMovementUpdated(const float DeltaTime, co
 	}
 }
 
+void UALSCharacterMovementComponent::TickComponent(const float DeltaTime, const ELevelTick TickType,
+												   FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// The owner may tick at the idle tick rate, wake it up as soon as it has something to do
+	AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(CharacterOwner);
+	if (ALSCharacter && ALSCharacter->IsIdle() && ALSCharacter->ShouldWakeFromIdle()) { ALSCharacter->WakeFromIdle(); }
+}
+
 void UALSCharacterMovementComponent::UpdateFromCompressedFlags(const uint8 Flags) // Client only
 {
 	Super::UpdateFromCompressedFlags(Flags);
@@ -36,6 +47,118 @@ void UALSCharacterMovementComponent::UpdateFromCompressedFlags(const uint8 Flags
 	bRequestMovementSettingsChange = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
 }
 
+void UALSCharacterMovementComponent::MoveAutonomous(const float ClientTimeStamp, const float DeltaTime,
+													const uint8 CompressedFlags, const FVector& NewAccel) // Server only
+{
+	// Replay the max speeds the client requested for this move, OnMovementUpdated applies them
+	const FALSCharacterNetworkMoveData* MoveData = static_cast<FALSCharacterNetworkMoveData*>(
+		GetCurrentNetworkMoveData());
+	if (MoveData)
+	{
+		MyNewMaxWalkSpeed = MoveData->MaxWalkSpeed;
+		MyNewMaxFlySpeed = MoveData->MaxFlySpeed;
+		MyNewMaxSwimSpeed = MoveData->MaxSwimSpeed;
+	}
+
+	// Start the mantle the client predicted on this move, the character validates it first
+	AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(CharacterOwner);
+	if (MoveData && MoveData->bHasMantleRequest && ALSCharacter)
+	{
+		FALSComponentAndTransform LedgeWS;
+		LedgeWS.Component = MoveData->MantleRequest.Component.Get();
+		LedgeWS.Transform = MoveData->MantleRequest.Target;
+		ALSCharacter->StartPredictedMantle(MoveData->MantleRequest.Height, LedgeWS, MoveData->MantleRequest.Type);
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+void UALSCharacterMovementComponent::PhysCustom(const float DeltaTime, const int32 Iterations)
+{
+	if (CustomMovementMode == MantleCustomMode)
+	{
+		PhysMantle(DeltaTime, Iterations);
+		return;
+	}
+
+	Super::PhysCustom(DeltaTime, Iterations);
+}
+
+void UALSCharacterMovementComponent::PhysMantle(const float DeltaTime, const int32 Iterations)
+{
+	if (DeltaTime < MIN_TICK_TIME) { return; }
+
+	AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(CharacterOwner);
+	if (!ALSCharacter)
+	{
+		SetMovementMode(MOVE_Falling);
+		return;
+	}
+
+	// Step 1: Advance the mantle at the play rate of its animation. The position only depends on the moves,
+	// so replaying them after a correction puts the character back on the same point of the mantle.
+	MantlePlaybackPosition = FMath::Min(MantlePlaybackPosition + DeltaTime * ALSCharacter->MantleParams.PlayRate,
+										ALSCharacter->MantleLength);
+
+	// Step 2: Move to the target of the mantle at this position.
+	const FTransform Target = ALSCharacter->MantleUpdate(MantlePlaybackPosition);
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	MoveUpdatedComponent(Target.GetLocation() - OldLocation, Target.GetRotation(), false);
+	Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime;
+
+	// Step 3: End the mantle once it played through.
+	if (MantlePlaybackPosition >= ALSCharacter->MantleLength) { ALSCharacter->MantleEnd(); }
+}
+
+void UALSCharacterMovementComponent::StartMantle()
+{
+	MantlePlaybackPosition = 0.0f;
+	SetMovementMode(MOVE_Custom, MantleCustomMode);
+}
+
+void UALSCharacterMovementComponent::RequestMantle(const float Height, const FALSComponentAndTransform& LedgeWS,
+												   const EALSMantleType Type)
+{
+	PendingMantleRequest.Component = LedgeWS.Component;
+	PendingMantleRequest.Target = LedgeWS.Transform;
+	PendingMantleRequest.Height = Height;
+	PendingMantleRequest.Type = Type;
+	bHasPendingMantleRequest = true;
+}
+
+void UALSCharacterMovementComponent::RejectMantle()
+{
+	bHasPendingMantleRequest = false;
+
+	FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+	if (!ClientData) { return; }
+
+	for (const FSavedMovePtr& SavedMove : ClientData->SavedMoves)
+	{
+		static_cast<FSavedMove_Faerie*>(SavedMove.Get())->bSavedMantleRequest = false;
+	}
+	if (ClientData->PendingMove.IsValid())
+	{
+		static_cast<FSavedMove_Faerie*>(ClientData->PendingMove.Get())->bSavedMantleRequest = false;
+	}
+}
+
+FTransform UALSCharacterMovementComponent::QuantizeMantleTarget(const FTransform& Target)
+{
+	// Matches SerializeMantleRequest, 1/10 unit for the location and 16 bits per rotation axis
+	const FVector Location = Target.GetLocation();
+	const FVector QuantizedLocation(FMath::RoundToFloat(Location.X * 10.0f) / 10.0f,
+									FMath::RoundToFloat(Location.Y * 10.0f) / 10.0f,
+									FMath::RoundToFloat(Location.Z * 10.0f) / 10.0f);
+
+	const FRotator Rotation = Target.Rotator();
+	const FRotator QuantizedRotation(FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotation.Pitch)),
+									 FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotation.Yaw)),
+									 FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotation.Roll)));
+
+	return FTransform(QuantizedRotation, QuantizedLocation, Target.GetScale3D());
+}
+
 class FNetworkPredictionData_Client* UALSCharacterMovementComponent::GetPredictionData_Client() const
 {
 	check(PawnOwner != nullptr);
@@ -57,6 +180,12 @@ void UALSCharacterMovementComponent::FSavedMove_Faerie::Clear()
 	Super::Clear();
 
 	bSavedRequestMovementSettingsChange = false;
+	SavedMaxWalkSpeed = 0.0f;
+	SavedMaxFlySpeed = 0.0f;
+	SavedMaxSwimSpeed = 0.0f;
+	SavedMantlePlaybackPosition = 0.0f;
+	bSavedMantleRequest = false;
+	SavedMantleRequest = FALSMantleRequest();
 }
 
 uint8 UALSCharacterMovementComponent::FSavedMove_Faerie::GetCompressedFlags() const
@@ -68,6 +197,38 @@ uint8 UALSCharacterMovementComponent::FSavedMove_Faerie::GetCompressedFlags() co
 	return Result;
 }
 
+bool UALSCharacterMovementComponent::FSavedMove_Faerie::CanCombineWith(const FSavedMovePtr& NewMove,
+																	   ACharacter* InCharacter,
+																	   const float MaxDelta) const
+{
+	// Moves starting a mantle, or with different max speeds have to be replayed separately on the server
+	const FSavedMove_Faerie* NewFaerieMove = static_cast<const FSavedMove_Faerie*>(NewMove.Get());
+	if (bSavedMantleRequest || NewFaerieMove->bSavedMantleRequest) { return false; }
+
+	if (SavedMaxWalkSpeed != NewFaerieMove->SavedMaxWalkSpeed || SavedMaxFlySpeed != NewFaerieMove->SavedMaxFlySpeed ||
+		SavedMaxSwimSpeed != NewFaerieMove->SavedMaxSwimSpeed)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void UALSCharacterMovementComponent::FSavedMove_Faerie::CombineWith(const FSavedMove_Character* OldMove,
+																	ACharacter* InCharacter, APlayerController* PC,
+																	const FVector& OldStartLocation)
+{
+	Super::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+
+	// The combined move starts where the old one did, so the mantle goes back to the old move's progress too
+	const FSavedMove_Faerie* OldFaerieMove = static_cast<const FSavedMove_Faerie*>(OldMove);
+	SavedMantlePlaybackPosition = OldFaerieMove->SavedMantlePlaybackPosition;
+
+	UALSCharacterMovementComponent* CharacterMovement = Cast<UALSCharacterMovementComponent>(
+		InCharacter->GetCharacterMovement());
+	if (CharacterMovement) { CharacterMovement->MantlePlaybackPosition = OldFaerieMove->SavedMantlePlaybackPosition; }
+}
+
 void UALSCharacterMovementComponent::FSavedMove_Faerie::SetMoveFor(ACharacter* Character, const float InDeltaTime,
 																   FVector const& NewAccel,
 																   class FNetworkPredictionData_Client_Character&
@@ -77,58 +238,142 @@ void UALSCharacterMovementComponent::FSavedMove_Faerie::SetMoveFor(ACharacter* C
 
 	UALSCharacterMovementComponent* CharacterMovement = Cast<UALSCharacterMovementComponent>(
 		Character->GetCharacterMovement());
-	if (CharacterMovement) { bSavedRequestMovementSettingsChange = CharacterMovement->bRequestMovementSettingsChange; }
+	if (CharacterMovement)
+	{
+		bSavedRequestMovementSettingsChange = CharacterMovement->bRequestMovementSettingsChange;
+		SavedMaxWalkSpeed = CharacterMovement->MyNewMaxWalkSpeed;
+		SavedMaxFlySpeed = CharacterMovement->MyNewMaxFlySpeed;
+		SavedMaxSwimSpeed = CharacterMovement->MyNewMaxSwimSpeed;
+		SavedMantlePlaybackPosition = CharacterMovement->MantlePlaybackPosition;
+
+		// The pending mantle starts on this move
+		bSavedMantleRequest = CharacterMovement->bHasPendingMantleRequest;
+		SavedMantleRequest = CharacterMovement->PendingMantleRequest;
+		CharacterMovement->bHasPendingMantleRequest = false;
+	}
 }
 
-UALSCharacterMovementComponent::FNetworkPredictionData_Client_Faerie::FNetworkPredictionData_Client_Faerie(
-	const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+void UALSCharacterMovementComponent::FSavedMove_Faerie::PrepMoveFor(ACharacter* Character)
+{
+	Super::PrepMoveFor(Character);
 
-FSavedMovePtr UALSCharacterMovementComponent::FNetworkPredictionData_Client_Faerie::AllocateNewMove()
+	// Replay the move with the max speeds it was originally made with
+	UALSCharacterMovementComponent* CharacterMovement = Cast<UALSCharacterMovementComponent>(
+		Character->GetCharacterMovement());
+	if (CharacterMovement)
+	{
+		CharacterMovement->MyNewMaxWalkSpeed = SavedMaxWalkSpeed;
+		CharacterMovement->MyNewMaxFlySpeed = SavedMaxFlySpeed;
+		CharacterMovement->MyNewMaxSwimSpeed = SavedMaxSwimSpeed;
+		CharacterMovement->MantlePlaybackPosition = SavedMantlePlaybackPosition;
+
+		// A correction may have moved the character back to before the mantle started
+		if (bSavedMantleRequest && !CharacterMovement->IsMantling())
+		{
+			CharacterMovement->SetMovementMode(MOVE_Custom, MantleCustomMode);
+		}
+	}
+}
+
+bool UALSCharacterMovementComponent::FSavedMove_Faerie::IsImportantMove(const FSavedMovePtr& LastAckedMove) const
 {
-	return MakeShared<FSavedMove_Faerie>();
+	// The server has to get the move a mantle starts on, or it never validates the mantle
+	return bSavedMantleRequest || Super::IsImportantMove(LastAckedMove);
 }
 
-void UALSCharacterMovementComponent::SetMaxWalkingSpeed(const float NewMaxWalkSpeed)
+void UALSCharacterMovementComponent::FALSCharacterNetworkMoveData::ClientFillNetworkMoveData(
+	const FSavedMove_Character& ClientMove, const ENetworkMoveType MoveType)
 {
-	if (PawnOwner->IsLocallyControlled())
-	{
-		MyNewMaxWalkSpeed = NewMaxWalkSpeed;
-		Server_SetMaxWalkingSpeed(NewMaxWalkSpeed);
-	}
-	bRequestMovementSettingsChange = true;
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_Faerie& FaerieMove = static_cast<const FSavedMove_Faerie&>(ClientMove);
+	MaxWalkSpeed = FaerieMove.SavedMaxWalkSpeed;
+	MaxFlySpeed = FaerieMove.SavedMaxFlySpeed;
+	MaxSwimSpeed = FaerieMove.SavedMaxSwimSpeed;
+	bHasMantleRequest = FaerieMove.bSavedMantleRequest;
+	MantleRequest = FaerieMove.SavedMantleRequest;
 }
 
-void UALSCharacterMovementComponent::Server_SetMaxWalkingSpeed_Implementation(const float NewMaxWalkSpeed)
+static void SerializeQuantizedMaxSpeed(FArchive& Ar, float& Speed)
 {
-	MyNewMaxWalkSpeed = NewMaxWalkSpeed;
+	// Speeds are quantized when they're requested, so this is lossless
+	uint16 QuantizedSpeed = Ar.IsSaving() ? static_cast<uint16>(FMath::RoundToInt(Speed * 4.0f)) : 0;
+	Ar << QuantizedSpeed;
+	if (Ar.IsLoading()) { Speed = QuantizedSpeed / 4.0f; }
 }
 
-void UALSCharacterMovementComponent::SetMaxFlyingSpeed(const float NewMaxFlySpeed)
+void UALSCharacterMovementComponent::FALSCharacterNetworkMoveData::SerializeMantleRequest(
+	FArchive& Ar, UPackageMap* PackageMap, FALSMantleRequest& Request)
 {
-	if (PawnOwner->IsLocallyControlled())
-	{
-		MyNewMaxFlySpeed = NewMaxFlySpeed;
-		Server_SetMaxFlyingSpeed(NewMaxFlySpeed);
-	}
-	bRequestMovementSettingsChange = true;
+	// Components that aren't supported for networking arrive as null, the server then uses the world space target
+	UObject* Component = Request.Component.Get();
+	PackageMap->SerializeObject(Ar, UPrimitiveComponent::StaticClass(), Component);
+	if (Ar.IsLoading()) { Request.Component = Cast<UPrimitiveComponent>(Component); }
+
+	// Targets are quantized when they're requested, so this is lossless
+	FVector Location = Request.Target.GetLocation();
+	FRotator Rotation = Request.Target.Rotator();
+	SerializePackedVector<10, 24>(Location, Ar);
+	Rotation.SerializeCompressedShort(Ar);
+	if (Ar.IsLoading()) { Request.Target = FTransform(Rotation, Location); }
+
+	Ar << Request.Height;
+
+	uint8 Type = static_cast<uint8>(Request.Type);
+	Ar << Type;
+	if (Ar.IsLoading()) { Request.Type = static_cast<EALSMantleType>(Type); }
 }
 
-void UALSCharacterMovementComponent::Server_SetMaxFlyingSpeed_Implementation(const float NewMaxFlySpeed)
+bool UALSCharacterMovementComponent::FALSCharacterNetworkMoveData::Serialize(
+	UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap,
+	const ENetworkMoveType MoveType)
 {
-	MyNewMaxFlySpeed = NewMaxFlySpeed;
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	SerializeQuantizedMaxSpeed(Ar, MaxWalkSpeed);
+	SerializeQuantizedMaxSpeed(Ar, MaxFlySpeed);
+	SerializeQuantizedMaxSpeed(Ar, MaxSwimSpeed);
+
+	uint8 bMantleRequestBit = bHasMantleRequest ? 1 : 0;
+	Ar.SerializeBits(&bMantleRequestBit, 1);
+	bHasMantleRequest = bMantleRequestBit != 0;
+	if (bHasMantleRequest) { SerializeMantleRequest(Ar, PackageMap, MantleRequest); }
+
+	return !Ar.IsError();
 }
 
-void UALSCharacterMovementComponent::SetMaxSwimmingSpeed(const float NewMaxSwimSpeed)
+UALSCharacterMovementComponent::FALSCharacterNetworkMoveDataContainer::FALSCharacterNetworkMoveDataContainer()
 {
-	if (PawnOwner->IsLocallyControlled())
-	{
-		MyNewMaxSwimSpeed = NewMaxSwimSpeed;
-		Server_SetMaxSwimmingSpeed(NewMaxSwimSpeed);
-	}
+	NewMoveData = &MoveData[0];
+	PendingMoveData = &MoveData[1];
+	OldMoveData = &MoveData[2];
+}
+
+UALSCharacterMovementComponent::FNetworkPredictionData_Client_Faerie::FNetworkPredictionData_Client_Faerie(
+	const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+
+FSavedMovePtr UALSCharacterMovementComponent::FNetworkPredictionData_Client_Faerie::AllocateNewMove()
+{
+	return MakeShared<FSavedMove_Faerie>();
+}
+
+void UALSCharacterMovementComponent::SetMaxWalkingSpeed(const float NewMaxWalkSpeed)
+{
+	// The server gets the speed with the next moves of the client
+	if (PawnOwner->IsLocallyControlled()) { MyNewMaxWalkSpeed = QuantizeMaxSpeed(NewMaxWalkSpeed); }
 	bRequestMovementSettingsChange = true;
 }
 
-void UALSCharacterMovementComponent::Server_SetMaxSwimmingSpeed_Implementation(const float NewMaxSwimSpeed)
+void UALSCharacterMovementComponent::SetMaxFlyingSpeed(const float NewMaxFlySpeed)
 {
-	MyNewMaxSwimSpeed = NewMaxSwimSpeed;
+	// The server gets the speed with the next moves of the client
+	if (PawnOwner->IsLocallyControlled()) { MyNewMaxFlySpeed = QuantizeMaxSpeed(NewMaxFlySpeed); }
+	bRequestMovementSettingsChange = true;
+}
+
+void UALSCharacterMovementComponent::SetMaxSwimmingSpeed(const float NewMaxSwimSpeed)
+{
+	// The server gets the speed with the next moves of the client
+	if (PawnOwner->IsLocallyControlled()) { MyNewMaxSwimSpeed = QuantizeMaxSpeed(NewMaxSwimSpeed); }
+	bRequestMovementSettingsChange = true;
 }
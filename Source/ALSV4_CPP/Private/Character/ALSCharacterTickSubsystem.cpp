@@ -0,0 +1,173 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSCharacterTickSubsystem.h"
+#include "Character/ALSBaseCharacter.h"
+#include "ALS_Settings.h"
+#include "Async/ParallelFor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Library/ALSStats.h"
+
+void FALSCharacterTickFunction::ExecuteTick(const float DeltaTime, const ELevelTick TickType,
+											ENamedThreads::Type CurrentThread,
+											const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target) { Target->ExecuteTick(DeltaTime, TickType); }
+}
+
+FString FALSCharacterTickFunction::DiagnosticMessage()
+{
+	return TEXT("FALSCharacterTickFunction");
+}
+
+void UALSCharacterTickSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Set up early, so that other tick functions can add it as a prerequisite before the first character registers
+	TickFunction.Target = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.TickGroup = TG_PrePhysics;
+}
+
+void UALSCharacterTickSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered()) { TickFunction.UnRegisterTickFunction(); }
+	Characters.Empty();
+	MovementStates.Empty();
+	TickOrder.Empty();
+	TickDeltaTimes.Empty();
+	ParallelCharacters.Empty();
+	Super::Deinitialize();
+}
+
+void UALSCharacterTickSubsystem::RegisterCharacter(AALSBaseCharacter* Character)
+{
+	if (!Character || Character->BatchedTickIndex != INDEX_NONE) { return; }
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	if (!TickFunction.IsTickFunctionRegistered()) { TickFunction.RegisterTickFunction(World->PersistentLevel); }
+
+	// Take over everything the actor tick waited for (the movement component ticks before its owner),
+	// and keep the mesh updating after the character.
+	for (const FTickPrerequisite& Prerequisite : Character->PrimaryActorTick.GetPrerequisites())
+	{
+		UObject* PrerequisiteObject = Prerequisite.PrerequisiteObject.Get();
+		if (PrerequisiteObject) { TickFunction.AddPrerequisite(PrerequisiteObject, *Prerequisite.PrerequisiteTickFunction); }
+	}
+	Character->GetMesh()->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
+
+	Character->PrimaryActorTick.SetTickFunctionEnable(false);
+	Character->BatchedTickIndex = Characters.Add(Character);
+	MovementStates.Add(Character->GetMovementState());
+}
+
+void UALSCharacterTickSubsystem::UnregisterCharacter(AALSBaseCharacter* Character)
+{
+	if (!Character || !Characters.IsValidIndex(Character->BatchedTickIndex)) { return; }
+
+	// Only free the slot here, the arrays may be iterated right now
+	Characters[Character->BatchedTickIndex] = nullptr;
+	Character->BatchedTickIndex = INDEX_NONE;
+	bHasFreeSlots = true;
+
+	for (const FTickPrerequisite& Prerequisite : Character->PrimaryActorTick.GetPrerequisites())
+	{
+		UObject* PrerequisiteObject = Prerequisite.PrerequisiteObject.Get();
+		if (PrerequisiteObject) { TickFunction.RemovePrerequisite(PrerequisiteObject, *Prerequisite.PrerequisiteTickFunction); }
+	}
+	Character->GetMesh()->PrimaryComponentTick.RemovePrerequisite(this, TickFunction);
+
+	Character->PrimaryActorTick.SetTickFunctionEnable(true);
+}
+
+void UALSCharacterTickSubsystem::ExecuteTick(const float DeltaTime, const ELevelTick TickType)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_BatchedCharacterTick);
+	CSV_SCOPED_TIMING_STAT(ALS, BatchedCharacterTick);
+
+	// Step 1: Compact the slots freed since the last tick.
+	if (bHasFreeSlots)
+	{
+		int32 NewNum = 0;
+		for (int32 Index = 0; Index < Characters.Num(); ++Index)
+		{
+			AALSBaseCharacter* Character = Characters[Index];
+			if (!Character) { continue; }
+
+			Characters[NewNum] = Character;
+			MovementStates[NewNum] = MovementStates[Index];
+			Character->BatchedTickIndex = NewNum++;
+		}
+		Characters.SetNum(NewNum);
+		MovementStates.SetNum(NewNum);
+		bHasFreeSlots = false;
+	}
+
+	// Step 2: Group the characters by movement state with a counting sort over the state array.
+	constexpr int32 StateCount = static_cast<int32>(EALSMovementState::Ragdoll) + 1;
+	int32 GroupStart[StateCount + 1] = {};
+	for (const EALSMovementState State : MovementStates) { ++GroupStart[static_cast<int32>(State) + 1]; }
+	for (int32 State = 1; State <= StateCount; ++State) { GroupStart[State] += GroupStart[State - 1]; }
+
+	TickOrder.SetNumUninitialized(Characters.Num(), false);
+	for (int32 Index = 0; Index < MovementStates.Num(); ++Index)
+	{
+		TickOrder[GroupStart[static_cast<int32>(MovementStates[Index])]++] = Index;
+	}
+
+	// Step 3: Find the delta time of each character. Idle characters only tick once per idle tick interval,
+	// with the time accumulated since their last tick. Zero skips the character.
+	const float IdleTickInterval = UALS_Settings::Get()->IdleTickInterval;
+	TickDeltaTimes.SetNumUninitialized(Characters.Num(), false);
+	for (int32 Index = 0; Index < Characters.Num(); ++Index)
+	{
+		AALSBaseCharacter* Character = Characters[Index];
+		TickDeltaTimes[Index] = 0.0f;
+		if (!IsValid(Character) || Character->IsActorBeingDestroyed()) { continue; }
+
+		Character->IdleSkippedTime += DeltaTime * Character->CustomTimeDilation;
+		if (Character->IsIdle() && Character->IdleSkippedTime < IdleTickInterval) { continue; }
+
+		TickDeltaTimes[Index] = Character->IdleSkippedTime;
+		Character->IdleSkippedTime = 0.0f;
+	}
+
+	// Step 4: Evaluate the locomotion math of all characters in parallel. Each character only writes to itself,
+	// the movement component and actor rotation writes are left to the serial tick. Fixed step locomotion doesn't
+	// evaluate per frame, so it has no frame to prepare.
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	if (Settings->bUseParallelLocomotion && !Settings->bUseFixedStepLocomotion)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ALS_ParallelLocomotion);
+		CSV_SCOPED_TIMING_STAT(ALS, ParallelLocomotion);
+
+		ParallelCharacters.Reset();
+		for (int32 Index = 0; Index < Characters.Num(); ++Index)
+		{
+			if (TickDeltaTimes[Index] != 0.0f) { ParallelCharacters.Add(Index); }
+		}
+
+		ParallelFor(ParallelCharacters.Num(), [this](const int32 ParallelIndex)
+		{
+			const int32 Index = ParallelCharacters[ParallelIndex];
+			Characters[Index]->EvaluateLocomotionFrame(TickDeltaTimes[Index]);
+		});
+	}
+
+	// Step 5: Tick. Characters registered from inside this loop start ticking in the next frame.
+	for (const int32 Index : TickOrder)
+	{
+		AALSBaseCharacter* Character = Characters[Index];
+		if (TickDeltaTimes[Index] == 0.0f || !IsValid(Character) || Character->IsActorBeingDestroyed()) { continue; }
+
+		Character->TickActor(TickDeltaTimes[Index], TickType, Character->PrimaryActorTick);
+	}
+}
@@ -8,6 +8,7 @@
 #include "Character/ALSPlayerCameraManager.h"
 #include "Character/ALSPlayerCharacter.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
+#include "Library/ALSStats.h"
 #include "Kismet/KismetMathLibrary.h"
 
 DEFINE_LOG_CATEGORY(LogAlsPlayerCameraManager)
@@ -84,6 +85,9 @@ FVector AALSPlayerCameraManager::CalculateAxisIndependentLag(const FVector Curre
 
 bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Location, FRotator& Rotation, float& FOV)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CustomCameraBehavior);
+	CSV_SCOPED_TIMING_STAT(ALS, CustomCameraBehavior);
+
 	if (!ControlledCharacter)
 	{
 		UE_LOG(LogAlsPlayerCameraManager, Warning, TEXT("Behavior has null Controlled Character"));
@@ -177,6 +181,7 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	Params.AddIgnoredActor(ControlledCharacter);
 
 	FHitResult HitResult;
+	FALSStats::CountSceneQuery();
 	World->SweepSingleByChannel(HitResult,
 								TraceOrigin,
 								TargetCameraLocation,
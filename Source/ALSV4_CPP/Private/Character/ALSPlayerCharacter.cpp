@@ -38,8 +38,7 @@ void AALSPlayerCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-	AnimData.ViewMode = ViewMode;
+	AnimCharacterInformation.ViewMode = ViewMode;
 	SetViewMode(ViewMode);
 }
 
@@ -298,7 +297,7 @@ void AALSPlayerCharacter::Server_SetViewMode_Implementation(const EALSViewMode N
 
 void AALSPlayerCharacter::OnViewModeChanged(const EALSViewMode PreviousViewMode)
 {
-	MainAnimInstance->GetCharacterInformationMutable().ViewMode = ViewMode;
+	AnimCharacterInformation.ViewMode = ViewMode;
 	switch (ViewMode)
 	{
 	case EALSViewMode::ThirdPerson:
@@ -0,0 +1,37 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/ALSAnimInstanceProxy.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+
+void FALSAnimInstanceProxy::Initialize(UAnimInstance* InAnimInstance)
+{
+	Super::Initialize(InAnimInstance);
+	ALSAnimInstance = Cast<UALSCharacterAnimInstance>(InAnimInstance);
+}
+
+void FALSAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, const float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	if (!ALSAnimInstance || !ALSAnimInstance->Character) { return; }
+
+	// Swap in the snapshot the character published at the end of its update, on the game thread.
+	// Nothing past this point may touch the character or its components.
+	ALSAnimInstance->ConsumeCharacterInformation();
+}
+
+void FALSAnimInstanceProxy::Update(const float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	if (ALSAnimInstance && !ALSAnimInstance->bWorkerUpdateOnGameThread)
+	{
+		ALSAnimInstance->NativeWorkerUpdateAnimation(DeltaSeconds);
+	}
+}
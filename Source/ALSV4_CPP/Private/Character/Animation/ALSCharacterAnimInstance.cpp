@@ -7,22 +7,116 @@
 
 
 #include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Character/Animation/ALSAnimInstanceProxy.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Library/ALSMathLibrary.h"
+#include "Library/ALSCurveCache.h"
+#include "Library/ALSLocomotionCoreConversion.h"
+#include "Library/ALSStats.h"
+#include "Character/Animation/ALSLocomotionBatchSubsystem.h"
 #include "Curves/CurveVector.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "ALS_Settings.h"
+#include "DrawDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
+
+#if ENABLE_DRAW_DEBUG
+static TAutoConsoleVariable<int32> CVarDrawAnimLOD(
+	TEXT("ALS.DrawAnimLOD"), 0,
+	TEXT("Draws the anim LOD tier above every ALS character, silver on frames a reduced rate tier skips. 0: off, 1: on"));
+#endif
 
 void UALSCharacterAnimInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 	Character = Cast<AALSBaseCharacter>(TryGetPawnOwner());
+
+	// Find the baked tables of the blend curves. They're evaluated on the worker thread, where the cache can't be used.
+	UWorld* World = GetWorld();
+	if (UALSCurveCacheSubsystem* CurveCache = World ? World->GetSubsystem<UALSCurveCacheSubsystem>() : nullptr)
+	{
+		BakedDiagonalScaleAmountCurve = CurveCache->FindOrBake(DiagonalScaleAmountCurve);
+		BakedStrideBlend_N_Walk = CurveCache->FindOrBake(StrideBlend_N_Walk);
+		BakedStrideBlend_N_Run = CurveCache->FindOrBake(StrideBlend_N_Run);
+		BakedStrideBlend_C_Walk = CurveCache->FindOrBake(StrideBlend_C_Walk);
+		BakedLandPredictionCurve = CurveCache->FindOrBake(LandPredictionCurve);
+		BakedLeanInAirCurve = CurveCache->FindOrBake(LeanInAirCurve);
+		BakedYawOffset_FB = CurveCache->FindOrBake(YawOffset_FB);
+		BakedYawOffset_LR = CurveCache->FindOrBake(YawOffset_LR);
+	}
+
+	// Spread the reduced rate anim LOD updates of different characters over different frames
+	AnimLODFrameCounter = static_cast<uint32>(FMath::Rand());
+
+	// Resolve the curve names once, so the per frame read doesn't need to build them again.
+	CurveHandles.Reset();
+	CurveHandles.Add(FName(TEXT("Enable_Transition")), &FALSAnimCurveValues::Enable_Transition);
+	CurveHandles.Add(FName(TEXT("Mask_AimOffset")), &FALSAnimCurveValues::Mask_AimOffset);
+	CurveHandles.Add(FName(TEXT("BasePose_N")), &FALSAnimCurveValues::BasePose_N);
+	CurveHandles.Add(FName(TEXT("BasePose_CLF")), &FALSAnimCurveValues::BasePose_CLF);
+	CurveHandles.Add(FName(TEXT("Layering_Spine_Add")), &FALSAnimCurveValues::Layering_Spine_Add);
+	CurveHandles.Add(FName(TEXT("Layering_Head_Add")), &FALSAnimCurveValues::Layering_Head_Add);
+	CurveHandles.Add(FName(TEXT("Layering_Arm_L_Add")), &FALSAnimCurveValues::Layering_Arm_L_Add);
+	CurveHandles.Add(FName(TEXT("Layering_Arm_R_Add")), &FALSAnimCurveValues::Layering_Arm_R_Add);
+	CurveHandles.Add(FName(TEXT("Layering_Hand_R")), &FALSAnimCurveValues::Layering_Hand_R);
+	CurveHandles.Add(FName(TEXT("Layering_Hand_L")), &FALSAnimCurveValues::Layering_Hand_L);
+	CurveHandles.Add(FName(TEXT("Enable_HandIK_L")), &FALSAnimCurveValues::Enable_HandIK_L);
+	CurveHandles.Add(FName(TEXT("Layering_Arm_L")), &FALSAnimCurveValues::Layering_Arm_L);
+	CurveHandles.Add(FName(TEXT("Enable_HandIK_R")), &FALSAnimCurveValues::Enable_HandIK_R);
+	CurveHandles.Add(FName(TEXT("Layering_Arm_R")), &FALSAnimCurveValues::Layering_Arm_R);
+	CurveHandles.Add(FName(TEXT("Layering_Arm_L_LS")), &FALSAnimCurveValues::Layering_Arm_L_LS);
+	CurveHandles.Add(FName(TEXT("Layering_Arm_R_LS")), &FALSAnimCurveValues::Layering_Arm_R_LS);
+	CurveHandles.Add(FName(TEXT("Enable_FootIK_L")), &FALSAnimCurveValues::Enable_FootIK_L);
+	CurveHandles.Add(FName(TEXT("Enable_FootIK_R")), &FALSAnimCurveValues::Enable_FootIK_R);
+	CurveHandles.Add(FName(TEXT("FootLock_L")), &FALSAnimCurveValues::FootLock_L);
+	CurveHandles.Add(FName(TEXT("FootLock_R")), &FALSAnimCurveValues::FootLock_R);
+	CurveHandles.Add(FName(TEXT("RotationAmount")), &FALSAnimCurveValues::RotationAmount);
+	CurveHandles.Add(FName(TEXT("Weight_Gait")), &FALSAnimCurveValues::Weight_Gait);
+	CurveHandles.Add(FName(TEXT("Mask_LandPrediction")), &FALSAnimCurveValues::Mask_LandPrediction);
+
+	if (Character && World && World->IsGameWorld() && UALS_Settings::Get()->bUseBatchedLocomotion)
+	{
+		if (UALSLocomotionBatchSubsystem* LocomotionBatch = World->GetSubsystem<UALSLocomotionBatchSubsystem>())
+		{
+			LocomotionBatch->RegisterAnimInstance(this);
+		}
+	}
+}
+
+void UALSCharacterAnimInstance::NativeUninitializeAnimation()
+{
+	UWorld* World = GetWorld();
+	if (UALSLocomotionBatchSubsystem* LocomotionBatch = World ? World->GetSubsystem<UALSLocomotionBatchSubsystem>() : nullptr)
+	{
+		LocomotionBatch->UnregisterAnimInstance(this);
+	}
+
+	Super::NativeUninitializeAnimation();
+}
+
+FAnimInstanceProxy* UALSCharacterAnimInstance::CreateAnimInstanceProxy()
+{
+	return new FALSAnimInstanceProxy(this);
+}
+
+void UALSCharacterAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	delete static_cast<FALSAnimInstanceProxy*>(InProxy);
 }
 
 void UALSCharacterAnimInstance::NativeUpdateAnimation(const float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_AnimUpdate);
+	CSV_SCOPED_TIMING_STAT(ALS, AnimUpdate);
+	FALSBenchmarkScope BenchmarkScope(FALSBenchmarkCounters::AnimUpdateCycles);
+
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
+	bWorkerUpdateOnGameThread = !UALS_Settings::Get()->bUseAnimWorkerUpdate;
+
 	if (!Character || DeltaSeconds == 0.0f)
 	{
 		// Fix character looking right on editor
@@ -32,15 +126,38 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(const float DeltaSeconds)
 		return;
 	}
 
-	// Update rest of character information. Others are reflected into anim bp when they're set inside character class
-	CharacterInformation.Velocity = Character->GetCharacterMovement()->Velocity;
-	CharacterInformation.MovementInput = Character->GetMovementInput();
-	CharacterInformation.AimingRotation = Character->GetAimingRotation();
-	CharacterInformation.CharacterActorRotation = Character->GetActorRotation();
+	// Pick the anim LOD tier first, it decides which of the features below run in this frame.
+	UpdateAnimLOD(DeltaSeconds);
+	if (bSkipAnimLODUpdate)
+	{
+		// The worker update blends the skipped frames, without it the proxy leaves that to the game thread too
+		if (bWorkerUpdateOnGameThread) { NativeWorkerUpdateAnimation(DeltaSeconds); }
+		return;
+	}
+	const float LODDeltaSeconds = AnimLODDeltaSeconds;
+
+	// Reduced rate tiers blend from the values shown so far. The update itself continues from the values it computed
+	// last time, not the blended ones.
+	if (bAnimLODBlending || AnimLODFeatures.UpdateInterval > 1)
+	{
+		CaptureAnimLODValues(AnimLODFromValues);
+		if (bAnimLODBlending) { BlendAnimLODValues(AnimLODTargetValues, AnimLODTargetValues, 1.0f); }
+	}
 
-	UpdateAimingValues(DeltaSeconds);
-	UpdateLayerValues();
-	UpdateFootIK(DeltaSeconds);
+	// Read all anim curves in a single pass. Both this and the worker thread part of the update use these values.
+	UpdateCurveValues();
+
+	// Character information is already swapped in by the anim instance proxy at this point.
+	// Everything below needs either scene queries, bone transforms or timers/montages, so it stays on the game thread.
+	if (AnimLODFeatures.bFootIK) { UpdateFootIK(LODDeltaSeconds); }
+	else
+	{
+		// Blend out of the foot IK offsets if the LOD tier doesn't allow foot IK
+		FootIKValues.FootLock_L_Alpha = 0.0f;
+		FootIKValues.FootLock_R_Alpha = 0.0f;
+		SetPelvisIKOffset(LODDeltaSeconds, FVector::ZeroVector, FVector::ZeroVector);
+		ResetIKOffsets(LODDeltaSeconds);
+	}
 
 	if (MovementState.Grounded())
 	{
@@ -56,38 +173,279 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(const float DeltaSeconds)
 			Grounded.bRotateR = false;
 		}
 
+		if (!Grounded.bShouldMove)
+		{
+			// Do While Not Moving
+			if (AnimLODFeatures.bTurnInPlace && CanTurnInPlace()) { TurnInPlaceCheck(LODDeltaSeconds); }
+			else { TurnInPlaceValues.ElapsedDelayTime = 0.0f; }
+			if (AnimLODFeatures.bDynamicTransitions && CanDynamicTransition()) { DynamicTransitionCheck(); }
+		}
+	}
+	else if (MovementState.Freefall())
+	{
+		// Do While Freefalling
+		UpdateInAirValues();
+	}
+	else if (MovementState.Ragdoll())
+	{
+		// Do While Ragdolling
+		UpdateRagdollValues();
+	}
+
+	// Without the worker update, the anim instance proxy leaves the rest of the update to the game thread as well
+	if (bWorkerUpdateOnGameThread) { NativeWorkerUpdateAnimation(DeltaSeconds); }
+}
+
+void UALSCharacterAnimInstance::PublishCharacterInformation(const FALSAnimCharacterInformation& NewCharacterInformation)
+{
+	PublishedCharacterInformation = NewCharacterInformation;
+	bHasPublishedCharacterInformation = true;
+}
+
+void UALSCharacterAnimInstance::ConsumeCharacterInformation()
+{
+	if (!bHasPublishedCharacterInformation) { return; }
+	bHasPublishedCharacterInformation = false;
+
+	// Flip the buffers, the next publish overwrites the whole back buffer
+	Swap(CharacterInformation, PublishedCharacterInformation);
+	MovementState = CharacterInformation.MovementState;
+	MovementAction = CharacterInformation.MovementAction;
+	RotationMode = CharacterInformation.RotationMode;
+	Gait = CharacterInformation.Gait;
+	Stance = CharacterInformation.Stance;
+	OverlayState = CharacterInformation.OverlayState;
+}
+
+void UALSCharacterAnimInstance::NativeWorkerUpdateAnimation(const float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_AnimWorkerUpdate);
+	CSV_SCOPED_TIMING_STAT(ALS, AnimWorkerUpdate);
+
+	if (!Character || DeltaSeconds == 0.0f) { return; }
+
+	if (bSkipAnimLODUpdate)
+	{
+		// Blend toward the values of the last update, so that they don't step at the reduced rate
+		if (bAnimLODBlending)
+		{
+			AnimLODBlendFrame = FMath::Min(AnimLODBlendFrame + 1, AnimLODBlendFrames);
+			BlendAnimLODValues(AnimLODFromValues, AnimLODTargetValues,
+							   static_cast<float>(AnimLODBlendFrame) / AnimLODBlendFrames);
+		}
+		return;
+	}
+
+	const float LODDeltaSeconds = AnimLODDeltaSeconds;
+
+	UpdateAimingValues(LODDeltaSeconds);
+	UpdateLayerValues();
+
+	if (MovementState.Grounded())
+	{
 		if (Grounded.bShouldMove)
 		{
 			// Do While Moving
-			UpdateMovementValues(DeltaSeconds);
+			UpdateMovementValues(LODDeltaSeconds);
 			UpdateRotationValues();
 		}
 		else
 		{
 			// Do While Not Moving
-			if (CanRotateInPlace()) { RotateInPlaceCheck(); }
+			if (AnimLODFeatures.bTurnInPlace && CanRotateInPlace()) { RotateInPlaceCheck(); }
 			else
 			{
 				Grounded.bRotateL = false;
 				Grounded.bRotateR = false;
 			}
-			if (CanTurnInPlace()) { TurnInPlaceCheck(DeltaSeconds); }
-			else { TurnInPlaceValues.ElapsedDelayTime = 0.0f; }
-			if (CanDynamicTransition()) { DynamicTransitionCheck(); }
 		}
 	}
 	else if (MovementState.Freefall())
 	{
 		// Do While Freefalling
-		UpdateInAirValues(DeltaSeconds);
+		UpdateInAirLeanValues(LODDeltaSeconds);
 	}
-	else if (MovementState.Ragdoll())
+
+	// Reduced rate tiers blend to the new values over the frames until the next update
+	bAnimLODBlending = AnimLODFeatures.UpdateInterval > 1;
+	if (bAnimLODBlending)
 	{
-		// Do While Ragdolling
-		UpdateRagdollValues();
+		CaptureAnimLODValues(AnimLODTargetValues);
+		AnimLODBlendFrame = 1;
+		AnimLODBlendFrames = AnimLODFeatures.UpdateInterval;
+		BlendAnimLODValues(AnimLODFromValues, AnimLODTargetValues, 1.0f / AnimLODBlendFrames);
 	}
 }
 
+void UALSCharacterAnimInstance::UpdateAnimLOD(const float DeltaSeconds)
+{
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	if (!Settings->bEnableAnimLOD || Settings->AnimLODTiers.Num() == 0)
+	{
+		AnimLODTier = 0;
+		AnimLODFeatures = FALSAnimLODTier();
+		AnimLODDeltaSeconds = DeltaSeconds;
+		bSkipAnimLODUpdate = false;
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	// Step 1: Find the significance of the character, using the closest local player view.
+	const USkeletalMeshComponent* OwnerComp = GetOwningComponent();
+	const FBoxSphereBounds& Bounds = OwnerComp->Bounds;
+	bool bHasView = false;
+	float Distance = BIG_NUMBER;
+	float ScreenSize = 0.0f;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController || !PlayerController->IsLocalController() || !PlayerController->PlayerCameraManager)
+		{
+			continue;
+		}
+
+		const APlayerCameraManager* CameraManager = PlayerController->PlayerCameraManager;
+		const float ViewDistance = FVector::Dist(CameraManager->GetCameraLocation(), Bounds.Origin);
+		const float ViewHalfWidth = ViewDistance * FMath::Tan(FMath::DegreesToRadians(CameraManager->GetFOVAngle() * 0.5f));
+		Distance = FMath::Min(Distance, ViewDistance);
+		ScreenSize = FMath::Max(ScreenSize, Bounds.SphereRadius / FMath::Max(ViewHalfWidth, 1.0f));
+		bHasView = true;
+	}
+
+	// Step 2: Pick the first tier the character is significant enough for.
+	const TArray<FALSAnimLODTier>& Tiers = Settings->AnimLODTiers;
+	int32 NewTier = 0;
+	if (bHasView)
+	{
+		NewTier = Tiers.Num() - 1;
+		if (!Settings->bUseLastAnimLODTierWhenNotRendered || OwnerComp->WasRecentlyRendered(0.2f))
+		{
+			for (int32 Index = 0; Index < Tiers.Num() - 1; ++Index)
+			{
+				if (Distance <= Tiers[Index].MaxDistance && ScreenSize >= Tiers[Index].MinScreenSize)
+				{
+					NewTier = Index;
+					break;
+				}
+			}
+		}
+	}
+
+	AnimLODTier = NewTier;
+	AnimLODFeatures = Tiers[NewTier];
+
+	// Step 3: Skip the update if the tier runs at a reduced rate. The skipped time is added to the next update,
+	// so that the interpolated values keep converging at the same speed.
+	AnimLODSkippedTime += DeltaSeconds;
+	bSkipAnimLODUpdate = ++AnimLODFrameCounter % FMath::Max(AnimLODFeatures.UpdateInterval, 1) != 0;
+	if (!bSkipAnimLODUpdate)
+	{
+		AnimLODDeltaSeconds = AnimLODSkippedTime;
+		AnimLODSkippedTime = 0.0f;
+	}
+
+#if ENABLE_DRAW_DEBUG
+	bool bDrawAnimLOD = CVarDrawAnimLOD.GetValueOnGameThread() != 0;
+#if WITH_EDITOR
+	bDrawAnimLOD |= Character->DrawDebug;
+#endif
+	if (bDrawAnimLOD)
+	{
+		DrawDebugString(World, FVector(0.0f, 0.0f, Bounds.BoxExtent.Z), FString::Printf(TEXT("Anim LOD %d"), AnimLODTier),
+						Character, bSkipAnimLODUpdate ? FColor::Silver : FColor::Green, 0.0f);
+	}
+#endif
+}
+
+void UALSCharacterAnimInstance::CaptureAnimLODValues(FALSAnimLODValues& OutValues) const
+{
+	OutValues.VelocityBlend = VelocityBlend;
+	OutValues.LeanAmount = LeanAmount;
+	OutValues.RelativeAccelerationAmount = RelativeAccelerationAmount;
+	OutValues.SmoothedAimingAngle = SmoothedAimingAngle;
+	OutValues.AimingValues = AimingValues;
+	OutValues.Grounded = Grounded;
+	OutValues.InAir = InAir;
+	OutValues.LayerBlendingValues = LayerBlendingValues;
+	OutValues.FootIKValues = FootIKValues;
+	OutValues.FlailRate = FlailRate;
+}
+
+void UALSCharacterAnimInstance::BlendAnimLODValues(const FALSAnimLODValues& From, const FALSAnimLODValues& To,
+												   const float Alpha)
+{
+	const auto Blend = [Alpha](auto& Value, const auto& FromValue, const auto& ToValue)
+	{
+		Value = FMath::Lerp(FromValue, ToValue, Alpha);
+	};
+
+	Blend(VelocityBlend.F, From.VelocityBlend.F, To.VelocityBlend.F);
+	Blend(VelocityBlend.B, From.VelocityBlend.B, To.VelocityBlend.B);
+	Blend(VelocityBlend.L, From.VelocityBlend.L, To.VelocityBlend.L);
+	Blend(VelocityBlend.R, From.VelocityBlend.R, To.VelocityBlend.R);
+	Blend(LeanAmount.LR, From.LeanAmount.LR, To.LeanAmount.LR);
+	Blend(LeanAmount.FB, From.LeanAmount.FB, To.LeanAmount.FB);
+	Blend(RelativeAccelerationAmount, From.RelativeAccelerationAmount, To.RelativeAccelerationAmount);
+	Blend(SmoothedAimingAngle, From.SmoothedAimingAngle, To.SmoothedAimingAngle);
+
+	// Aiming
+	const FALSAnimGraphAimingValues& FromAiming = From.AimingValues;
+	const FALSAnimGraphAimingValues& ToAiming = To.AimingValues;
+	Blend(AimingValues.SmoothedAimingRotation, FromAiming.SmoothedAimingRotation, ToAiming.SmoothedAimingRotation);
+	Blend(AimingValues.SpineRotation, FromAiming.SpineRotation, ToAiming.SpineRotation);
+	Blend(AimingValues.AimingAngle, FromAiming.AimingAngle, ToAiming.AimingAngle);
+	Blend(AimingValues.AimSweepTime, FromAiming.AimSweepTime, ToAiming.AimSweepTime);
+	Blend(AimingValues.InputYawOffsetTime, FromAiming.InputYawOffsetTime, ToAiming.InputYawOffsetTime);
+	Blend(AimingValues.ForwardYawTime, FromAiming.ForwardYawTime, ToAiming.ForwardYawTime);
+	Blend(AimingValues.LeftYawTime, FromAiming.LeftYawTime, ToAiming.LeftYawTime);
+	Blend(AimingValues.RightYawTime, FromAiming.RightYawTime, ToAiming.RightYawTime);
+
+	// Grounded and In Air
+	Blend(Grounded.DiagonalScaleAmount, From.Grounded.DiagonalScaleAmount, To.Grounded.DiagonalScaleAmount);
+	Blend(Grounded.WalkRunBlend, From.Grounded.WalkRunBlend, To.Grounded.WalkRunBlend);
+	Blend(Grounded.StandingPlayRate, From.Grounded.StandingPlayRate, To.Grounded.StandingPlayRate);
+	Blend(Grounded.CrouchingPlayRate, From.Grounded.CrouchingPlayRate, To.Grounded.CrouchingPlayRate);
+	Blend(Grounded.StrideBlend, From.Grounded.StrideBlend, To.Grounded.StrideBlend);
+	Blend(Grounded.FYaw, From.Grounded.FYaw, To.Grounded.FYaw);
+	Blend(Grounded.BYaw, From.Grounded.BYaw, To.Grounded.BYaw);
+	Blend(Grounded.LYaw, From.Grounded.LYaw, To.Grounded.LYaw);
+	Blend(Grounded.RYaw, From.Grounded.RYaw, To.Grounded.RYaw);
+	Blend(InAir.FallSpeed, From.InAir.FallSpeed, To.InAir.FallSpeed);
+	Blend(InAir.LandPrediction, From.InAir.LandPrediction, To.InAir.LandPrediction);
+	Blend(FlailRate, From.FlailRate, To.FlailRate);
+
+	// Layer Blending
+	const FALSAnimGraphLayerBlending& FromLayers = From.LayerBlendingValues;
+	const FALSAnimGraphLayerBlending& ToLayers = To.LayerBlendingValues;
+	Blend(LayerBlendingValues.EnableAimOffset, FromLayers.EnableAimOffset, ToLayers.EnableAimOffset);
+	Blend(LayerBlendingValues.BasePose_N, FromLayers.BasePose_N, ToLayers.BasePose_N);
+	Blend(LayerBlendingValues.BasePose_CLF, FromLayers.BasePose_CLF, ToLayers.BasePose_CLF);
+	Blend(LayerBlendingValues.Spine_Add, FromLayers.Spine_Add, ToLayers.Spine_Add);
+	Blend(LayerBlendingValues.Head_Add, FromLayers.Head_Add, ToLayers.Head_Add);
+	Blend(LayerBlendingValues.Arm_L_Add, FromLayers.Arm_L_Add, ToLayers.Arm_L_Add);
+	Blend(LayerBlendingValues.Arm_R_Add, FromLayers.Arm_R_Add, ToLayers.Arm_R_Add);
+	Blend(LayerBlendingValues.Hand_R, FromLayers.Hand_R, ToLayers.Hand_R);
+	Blend(LayerBlendingValues.Hand_L, FromLayers.Hand_L, ToLayers.Hand_L);
+	Blend(LayerBlendingValues.EnableHandIK_L, FromLayers.EnableHandIK_L, ToLayers.EnableHandIK_L);
+	Blend(LayerBlendingValues.EnableHandIK_R, FromLayers.EnableHandIK_R, ToLayers.EnableHandIK_R);
+	Blend(LayerBlendingValues.Arm_L_LS, FromLayers.Arm_L_LS, ToLayers.Arm_L_LS);
+	Blend(LayerBlendingValues.Arm_L_MS, FromLayers.Arm_L_MS, ToLayers.Arm_L_MS);
+	Blend(LayerBlendingValues.Arm_R_LS, FromLayers.Arm_R_LS, ToLayers.Arm_R_LS);
+	Blend(LayerBlendingValues.Arm_R_MS, FromLayers.Arm_R_MS, ToLayers.Arm_R_MS);
+
+	// Foot IK offsets. Foot locks snap on purpose and aren't blended.
+	const FALSAnimGraphFootIK& FromFootIK = From.FootIKValues;
+	const FALSAnimGraphFootIK& ToFootIK = To.FootIKValues;
+	Blend(FootIKValues.FootOffset_L_Location, FromFootIK.FootOffset_L_Location, ToFootIK.FootOffset_L_Location);
+	Blend(FootIKValues.FootOffset_R_Location, FromFootIK.FootOffset_R_Location, ToFootIK.FootOffset_R_Location);
+	Blend(FootIKValues.FootOffset_L_Rotation, FromFootIK.FootOffset_L_Rotation, ToFootIK.FootOffset_L_Rotation);
+	Blend(FootIKValues.FootOffset_R_Rotation, FromFootIK.FootOffset_R_Rotation, ToFootIK.FootOffset_R_Rotation);
+	Blend(FootIKValues.PelvisOffset, FromFootIK.PelvisOffset, ToFootIK.PelvisOffset);
+	Blend(FootIKValues.PelvisAlpha, FromFootIK.PelvisAlpha, ToFootIK.PelvisAlpha);
+}
+
 void UALSCharacterAnimInstance::PlayTransition(const FALSDynamicMontageParams& Parameters)
 {
 	PlaySlotAnimationAsDynamicMontage(Parameters.Animation,
@@ -139,12 +497,12 @@ bool UALSCharacterAnimInstance::CanRotateInPlace() const
 bool UALSCharacterAnimInstance::CanTurnInPlace() const
 {
 	return RotationMode.LookingDirection() && CharacterInformation.ViewMode == EALSViewMode::ThirdPerson &&
-		GetCurveValue(FName(TEXT("Enable_Transition"))) > 0.99f;
+		CurveValues.Enable_Transition > 0.99f;
 }
 
 bool UALSCharacterAnimInstance::CanDynamicTransition() const
 {
-	return GetCurveValue(FName(TEXT("Enable_Transition"))) == 1.0f;
+	return CurveValues.Enable_Transition == 1.0f;
 }
 
 void UALSCharacterAnimInstance::PlayDynamicTransitionDelay() { bCanPlayDynamicTransition = true; }
@@ -153,16 +511,45 @@ void UALSCharacterAnimInstance::OnJumpedDelay() { InAir.bJumped = false; }
 
 void UALSCharacterAnimInstance::OnPivotDelay() { Grounded.bPivot = false; }
 
+void UALSCharacterAnimInstance::UpdateCurveValues()
+{
+	if (CurveValuesFrameCounter == GFrameCounter) { return; }
+	CurveValuesFrameCounter = GFrameCounter;
+	FALSBenchmarkScope BenchmarkScope(FALSBenchmarkCounters::CurveReadCycles);
+
+	if (!UALS_Settings::Get()->bReadAnimCurvesInOnePass)
+	{
+		for (const TPair<FName, float FALSAnimCurveValues::*>& Handle : CurveHandles)
+		{
+			CurveValues.*(Handle.Value) = GetCurveValue(Handle.Key);
+		}
+		return;
+	}
+
+	// Step 1: Curves missing from the list read as 0, the same as through GetCurveValue.
+	CurveValues = FALSAnimCurveValues();
+
+	// Step 2: Walk the curve list once and pick out the ALS curves.
+	for (const TPair<FName, float>& Curve : GetAnimationCurveList(EAnimCurveType::AttributeCurve))
+	{
+		if (float FALSAnimCurveValues::* const* Handle = CurveHandles.Find(Curve.Key)) { CurveValues.*(*Handle) = Curve.Value; }
+	}
+}
+
 void UALSCharacterAnimInstance::UpdateAimingValues(const float DeltaSeconds)
 {
 	// Interp the Aiming Rotation value to achieve smooth aiming rotation changes.
 	// Interpolating the rotation before calculating the angle ensures the value is not affected by changes
 	// in actor rotation, allowing slow aiming rotation changes with fast actor rotation changes.
 
-	AimingValues.SmoothedAimingRotation = FMath::RInterpTo(AimingValues.SmoothedAimingRotation,
-														   CharacterInformation.AimingRotation,
-														   DeltaSeconds,
-														   Config.SmoothedAimingRotationInterpSpeed);
+	if (AnimLODFeatures.bAimSmoothing)
+	{
+		AimingValues.SmoothedAimingRotation = FMath::RInterpTo(AimingValues.SmoothedAimingRotation,
+															   CharacterInformation.AimingRotation,
+															   DeltaSeconds,
+															   Config.SmoothedAimingRotationInterpSpeed);
+	}
+	else { AimingValues.SmoothedAimingRotation = CharacterInformation.AimingRotation; }
 
 	// Calculate the Aiming angle and Smoothed Aiming Angle by getting
 	// the delta between the aiming rotation and the actor rotation.
@@ -220,39 +607,40 @@ void UALSCharacterAnimInstance::UpdateAimingValues(const float DeltaSeconds)
 void UALSCharacterAnimInstance::UpdateLayerValues()
 {
 	// Get the Aim Offset weight by getting the opposite of the Aim Offset Mask.
-	LayerBlendingValues.EnableAimOffset = FMath::Lerp(1.0f, 0.0f, GetCurveValue(FName(TEXT("Mask_AimOffset"))));
+	LayerBlendingValues.EnableAimOffset = FMath::Lerp(1.0f, 0.0f, CurveValues.Mask_AimOffset);
 	// Set the Base Pose weights
-	LayerBlendingValues.BasePose_N = GetCurveValue(FName(TEXT("BasePose_N")));
-	LayerBlendingValues.BasePose_CLF = GetCurveValue(FName(TEXT("BasePose_CLF")));
+	LayerBlendingValues.BasePose_N = CurveValues.BasePose_N;
+	LayerBlendingValues.BasePose_CLF = CurveValues.BasePose_CLF;
 	// Set the Additive amount weights for each body part
-	LayerBlendingValues.Spine_Add = GetCurveValue(FName(TEXT("Layering_Spine_Add")));
-	LayerBlendingValues.Head_Add = GetCurveValue(FName(TEXT("Layering_Head_Add")));
-	LayerBlendingValues.Arm_L_Add = GetCurveValue(FName(TEXT("Layering_Arm_L_Add")));
-	LayerBlendingValues.Arm_R_Add = GetCurveValue(FName(TEXT("Layering_Arm_R_Add")));
+	LayerBlendingValues.Spine_Add = CurveValues.Layering_Spine_Add;
+	LayerBlendingValues.Head_Add = CurveValues.Layering_Head_Add;
+	LayerBlendingValues.Arm_L_Add = CurveValues.Layering_Arm_L_Add;
+	LayerBlendingValues.Arm_R_Add = CurveValues.Layering_Arm_R_Add;
 	// Set the Hand Override weights
-	LayerBlendingValues.Hand_R = GetCurveValue(FName(TEXT("Layering_Hand_R")));
-	LayerBlendingValues.Hand_L = GetCurveValue(FName(TEXT("Layering_Hand_L")));
+	LayerBlendingValues.Hand_R = CurveValues.Layering_Hand_R;
+	LayerBlendingValues.Hand_L = CurveValues.Layering_Hand_L;
 	// Blend and set the Hand IK weights to ensure they only are weighted if allowed by the Arm layers.
-	LayerBlendingValues.EnableHandIK_L = FMath::Lerp(0.0f, GetCurveValue(FName(TEXT("Enable_HandIK_L"))),
-	                                                 GetCurveValue(FName(TEXT("Layering_Arm_L"))));
-	LayerBlendingValues.EnableHandIK_R = FMath::Lerp(0.0f, GetCurveValue(FName(TEXT("Enable_HandIK_R"))),
-	                                                 GetCurveValue(FName(TEXT("Layering_Arm_R"))));
+	LayerBlendingValues.EnableHandIK_L = FMath::Lerp(0.0f, CurveValues.Enable_HandIK_L, CurveValues.Layering_Arm_L);
+	LayerBlendingValues.EnableHandIK_R = FMath::Lerp(0.0f, CurveValues.Enable_HandIK_R, CurveValues.Layering_Arm_R);
 	// Set whether the arms should blend in mesh space or local space.
 	// The Mesh space weight will always be 1 unless the Local Space (LS) curve is fully weighted.
-	LayerBlendingValues.Arm_L_LS = GetCurveValue(FName(TEXT("Layering_Arm_L_LS")));
+	LayerBlendingValues.Arm_L_LS = CurveValues.Layering_Arm_L_LS;
 	LayerBlendingValues.Arm_L_MS = static_cast<float>(1 - FMath::FloorToInt(LayerBlendingValues.Arm_L_LS));
-	LayerBlendingValues.Arm_R_LS = GetCurveValue(FName(TEXT("Layering_Arm_R_LS")));
+	LayerBlendingValues.Arm_R_LS = CurveValues.Layering_Arm_R_LS;
 	LayerBlendingValues.Arm_R_MS = static_cast<float>(1 - FMath::FloorToInt(LayerBlendingValues.Arm_R_LS));
 }
 
 void UALSCharacterAnimInstance::UpdateFootIK(const float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_UpdateFootIK);
+	CSV_SCOPED_TIMING_STAT(ALS, UpdateFootIK);
+
 	FVector FootOffsetLTarget, FootOffsetRTarget = FVector::ZeroVector;
 
 	// Update Foot Locking values.
 	SetFootLocking(DeltaSeconds,
-				   FName(TEXT("Enable_FootIK_L")),
-				   FName(TEXT("FootLock_L")),
+				   CurveValues.Enable_FootIK_L,
+				   CurveValues.FootLock_L,
 				   FName(TEXT("ik_foot_l")),
 				   FootIKValues.FootLock_L_Alpha,
 				   FootIKValues.UseFootLockCurve_L,
@@ -260,8 +648,8 @@ void UALSCharacterAnimInstance::UpdateFootIK(const float DeltaSeconds)
 				   FootIKValues.FootLock_L_Rotation);
 
 	SetFootLocking(DeltaSeconds,
-				   FName(TEXT("Enable_FootIK_R")),
-				   FName(TEXT("FootLock_R")),
+				   CurveValues.Enable_FootIK_R,
+				   CurveValues.FootLock_R,
 				   FName(TEXT("ik_foot_r")),
 				   FootIKValues.FootLock_R_Alpha,
 				   FootIKValues.UseFootLockCurve_R,
@@ -278,16 +666,18 @@ void UALSCharacterAnimInstance::UpdateFootIK(const float DeltaSeconds)
 	{
 		// Update all Foot Lock and Foot Offset values when not In Air
 		SetFootOffsets(DeltaSeconds,
-					   FName(TEXT("Enable_FootIK_L")),
+					   CurveValues.Enable_FootIK_L,
 					   FName(TEXT("ik_foot_l")),
 					   FName(TEXT("root")),
+					   FootIKTrace_L,
 					   FootOffsetLTarget,
 					   FootIKValues.FootOffset_L_Location,
 					   FootIKValues.FootOffset_L_Rotation);
 		SetFootOffsets(DeltaSeconds,
-					   FName(TEXT("Enable_FootIK_R")),
+					   CurveValues.Enable_FootIK_R,
 					   FName(TEXT("ik_foot_r")),
 					   FName(TEXT("root")),
+					   FootIKTrace_R,
 					   FootOffsetRTarget,
 					   FootIKValues.FootOffset_R_Location,
 					   FootIKValues.FootOffset_R_Rotation);
@@ -295,25 +685,25 @@ void UALSCharacterAnimInstance::UpdateFootIK(const float DeltaSeconds)
 	}
 }
 
-void UALSCharacterAnimInstance::SetFootLocking(const float DeltaSeconds, const FName EnableFootIKCurve,
-											   const FName FootLockCurve, const FName IKFootBone,
+void UALSCharacterAnimInstance::SetFootLocking(const float DeltaSeconds, const float EnableFootIKCurve,
+											   const float FootLockCurve, const FName IKFootBone,
 											   float& CurFootLockAlpha, bool& UseFootLockCurve, FVector& CurFootLockLoc,
 											   FRotator& CurFootLockRot) const
 {
-	if (GetCurveValue(EnableFootIKCurve) <= 0.0f) { return; }
+	if (EnableFootIKCurve <= 0.0f) { return; }
 
 	// Step 1: Set Local FootLock Curve value
 	float FootLockCurveVal;
 
 	if (UseFootLockCurve)
 	{
-		UseFootLockCurve = FMath::Abs(GetCurveValue(FName(TEXT("RotationAmount")))) <= 0.001f ||
+		UseFootLockCurve = FMath::Abs(CurveValues.RotationAmount) <= 0.001f ||
 			Character->GetLocalRole() != ROLE_AutonomousProxy;
-		FootLockCurveVal = GetCurveValue(FootLockCurve);
+		FootLockCurveVal = FootLockCurve;
 	}
 	else
 	{
-		UseFootLockCurve = GetCurveValue(FootLockCurve) >= 0.99f;
+		UseFootLockCurve = FootLockCurve >= 0.99f;
 		FootLockCurveVal = 0.0f;
 	}
 
@@ -366,8 +756,7 @@ void UALSCharacterAnimInstance::SetPelvisIKOffset(const float DeltaSeconds, cons
 												  const FVector FootOffsetRTarget)
 {
 	// Calculate the Pelvis Alpha by finding the average Foot IK weight. If the alpha is 0, clear the offset.
-	FootIKValues.PelvisAlpha = (GetCurveValue(FName(TEXT("Enable_FootIK_L"))) + GetCurveValue(
-		FName(TEXT("Enable_FootIK_R")))) / 2.0f;
+	FootIKValues.PelvisAlpha = (CurveValues.Enable_FootIK_L + CurveValues.Enable_FootIK_R) / 2.0f;
 
 	if (FootIKValues.PelvisAlpha > 0.0f)
 	{
@@ -396,12 +785,13 @@ void UALSCharacterAnimInstance::ResetIKOffsets(const float DeltaSeconds)
 	                                                      FRotator::ZeroRotator, DeltaSeconds, 15.0f);
 }
 
-void UALSCharacterAnimInstance::SetFootOffsets(const float DeltaSeconds, const FName EnableFootIKCurve,
-											   const FName IKFootBone, const FName RootBone, FVector& CurLocationTarget,
-											   FVector& CurLocationOffset, FRotator& CurRotationOffset) const
+void UALSCharacterAnimInstance::SetFootOffsets(const float DeltaSeconds, const float EnableFootIKCurve,
+											   const FName IKFootBone, const FName RootBone, FALSFootIKTrace& FootIKTrace,
+											   FVector& CurLocationTarget, FVector& CurLocationOffset,
+											   FRotator& CurRotationOffset) const
 {
 	// Only update Foot IK offset values if the Foot IK curve has a weight. If it equals 0, clear the offset values.
-	if (GetCurveValue(EnableFootIKCurve) <= 0)
+	if (EnableFootIKCurve <= 0)
 	{
 		CurLocationOffset = FVector::ZeroVector;
 		CurRotationOffset = FRotator::ZeroRotator;
@@ -414,21 +804,11 @@ void UALSCharacterAnimInstance::SetFootOffsets(const float DeltaSeconds, const F
 	FVector IKFootFloorLoc = OwnerComp->GetSocketLocation(IKFootBone);
 	IKFootFloorLoc.Z = OwnerComp->GetSocketLocation(RootBone).Z;
 
-	UWorld* World = GetWorld();
-	check(World);
-
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(Character);
-
 	FHitResult HitResult;
-	World->LineTraceSingleByChannel(HitResult,
-									IKFootFloorLoc + FVector(0.0, 0.0, Config.IK_TraceDistanceAboveFoot),
-									IKFootFloorLoc - FVector(0.0, 0.0, Config.IK_TraceDistanceBelowFoot),
-									ECC_Visibility,
-									Params);
+	const bool bHasHitResult = TraceFootFloor(IKFootFloorLoc, FootIKTrace, HitResult);
 
 	FRotator TargetRotOffset = FRotator::ZeroRotator;
-	if (Character->GetCharacterMovement()->IsWalkable(HitResult))
+	if (bHasHitResult && Character->GetCharacterMovement()->IsWalkable(HitResult))
 	{
 		FVector ImpactPoint = HitResult.ImpactPoint;
 		FVector ImpactNormal = HitResult.ImpactNormal;
@@ -453,6 +833,71 @@ void UALSCharacterAnimInstance::SetFootOffsets(const float DeltaSeconds, const F
 	CurRotationOffset = FMath::RInterpTo(CurRotationOffset, TargetRotOffset, DeltaSeconds, 30.0f);
 }
 
+bool UALSCharacterAnimInstance::TraceFootFloor(const FVector& IKFootFloorLoc, FALSFootIKTrace& FootIKTrace,
+											   FHitResult& OutHitResult) const
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	FCollisionQueryParams Params;
+	Params.AddIgnoredActor(Character);
+
+	const FVector TraceStart = IKFootFloorLoc + FVector(0.0, 0.0, Config.IK_TraceDistanceAboveFoot);
+	const FVector TraceEnd = IKFootFloorLoc - FVector(0.0, 0.0, Config.IK_TraceDistanceBelowFoot);
+
+	if (!Config.bUseAsyncFootIKTraces)
+	{
+		FALSStats::CountSceneQuery();
+		World->LineTraceSingleByChannel(OutHitResult, TraceStart, TraceEnd, ECC_Visibility, Params);
+		return true;
+	}
+
+	// Step 1: Consume the result of the trace submitted in the last frame. If the anim instance skipped frames,
+	// the trace data is already gone and the handle is dropped, so that a new trace gets submitted below.
+	if (FootIKTrace.Handle.IsValid())
+	{
+		FTraceDatum TraceDatum;
+		if (World->QueryTraceData(FootIKTrace.Handle, TraceDatum))
+		{
+			FootIKTrace.HitResult = TraceDatum.OutHits.Num() > 0 ? TraceDatum.OutHits[0] : FHitResult();
+			FootIKTrace.TraceLocation = FootIKTrace.PendingTraceLocation;
+			FootIKTrace.bHasResult = true;
+			FootIKTrace.Handle.Invalidate();
+		}
+		else if (!World->IsTraceHandleValid(FootIKTrace.Handle, false)) { FootIKTrace.Handle.Invalidate(); }
+	}
+
+	// Step 2: Submit a new trace only if the foot moved far enough from the last traced location,
+	// or if the character is standing on a different floor component.
+	const TWeakObjectPtr<UPrimitiveComponent>& FloorComponent =
+		Character->GetCharacterMovement()->CurrentFloor.HitResult.Component;
+	const bool bShouldTrace = !FootIKTrace.bHasResult || FootIKTrace.FloorComponent != FloorComponent ||
+		FVector::DistSquared(IKFootFloorLoc, FootIKTrace.TraceLocation) > FMath::Square(Config.IK_TraceReuseDistance);
+	if (bShouldTrace && !FootIKTrace.Handle.IsValid())
+	{
+		FALSStats::CountSceneQuery();
+		FootIKTrace.Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd,
+															ECC_Visibility, Params);
+		FootIKTrace.PendingTraceLocation = IKFootFloorLoc;
+		FootIKTrace.FloorComponent = FloorComponent;
+	}
+
+	if (!FootIKTrace.bHasResult) { return false; }
+
+	// Step 3: The cached result was traced from an older foot location.
+	// Slide its impact point along the hit surface to below the current foot location.
+	OutHitResult = FootIKTrace.HitResult;
+	if (OutHitResult.bBlockingHit && OutHitResult.ImpactNormal.Z > KINDA_SMALL_NUMBER)
+	{
+		const FVector FootDelta = IKFootFloorLoc - FootIKTrace.TraceLocation;
+		const FVector& Normal = OutHitResult.ImpactNormal;
+		OutHitResult.ImpactPoint.X += FootDelta.X;
+		OutHitResult.ImpactPoint.Y += FootDelta.Y;
+		OutHitResult.ImpactPoint.Z -= (Normal.X * FootDelta.X + Normal.Y * FootDelta.Y) / Normal.Z;
+	}
+	return true;
+}
+
 void UALSCharacterAnimInstance::RotateInPlaceCheck()
 {
 	// Step 1: Check if the character should rotate left or right by checking if the Aiming Angle exceeds the threshold.
@@ -537,6 +982,20 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 
 void UALSCharacterAnimInstance::UpdateMovementValues(const float DeltaSeconds)
 {
+	if (BatchedMovementValues.FrameCounter == GFrameCounter && BatchedMovementValues.DeltaSeconds == DeltaSeconds)
+	{
+		// The locomotion batch already did the math below for this frame, only apply its results.
+		VelocityBlend = BatchedMovementValues.VelocityBlend;
+		Grounded.DiagonalScaleAmount = BatchedMovementValues.DiagonalScaleAmount;
+		RelativeAccelerationAmount = BatchedMovementValues.RelativeAccelerationAmount;
+		LeanAmount = BatchedMovementValues.LeanAmount;
+		Grounded.WalkRunBlend = CalculateWalkRunBlend();
+		Grounded.StrideBlend = BatchedMovementValues.StrideBlend;
+		Grounded.StandingPlayRate = BatchedMovementValues.StandingPlayRate;
+		Grounded.CrouchingPlayRate = BatchedMovementValues.CrouchingPlayRate;
+		return;
+	}
+
 	// Interp and set the Velocity Blend.
 	const FALSVelocityBlend& TargetBlend = CalculateVelocityBlend();
 	VelocityBlend.F = FMath::FInterpTo(VelocityBlend.F, TargetBlend.F, DeltaSeconds, Config.VelocityBlendInterpSpeed);
@@ -579,23 +1038,26 @@ void UALSCharacterAnimInstance::UpdateRotationValues()
 	// behaves for each movement direction.
 	FRotator Delta = CharacterInformation.Velocity.ToOrientationRotator() - CharacterInformation.AimingRotation;
 	Delta.Normalize();
-	const FVector& FBOffset = YawOffset_FB->GetVectorValue(Delta.Yaw);
+	const FVector& FBOffset = UALSCurveCacheSubsystem::GetVectorValue(YawOffset_FB, BakedYawOffset_FB, Delta.Yaw);
 	Grounded.FYaw = FBOffset.X;
 	Grounded.BYaw = FBOffset.Y;
-	const FVector& LROffset = YawOffset_LR->GetVectorValue(Delta.Yaw);
+	const FVector& LROffset = UALSCurveCacheSubsystem::GetVectorValue(YawOffset_LR, BakedYawOffset_LR, Delta.Yaw);
 	Grounded.LYaw = LROffset.X;
 	Grounded.RYaw = LROffset.Y;
 }
 
-void UALSCharacterAnimInstance::UpdateInAirValues(const float DeltaSeconds)
+void UALSCharacterAnimInstance::UpdateInAirValues()
 {
 	// Update the fall speed. Setting this value only while in the air allows you to use it within the AnimGraph for the landing strength.
 	// If not, the Z velocity would return to 0 on landing.
 	InAir.FallSpeed = CharacterInformation.Velocity.Z;
 
 	// Set the Land Prediction weight.
-	InAir.LandPrediction = CalculateLandPrediction();
+	InAir.LandPrediction = AnimLODFeatures.bLandPrediction ? CalculateLandPrediction() : 0.0f;
+}
 
+void UALSCharacterAnimInstance::UpdateInAirLeanValues(const float DeltaSeconds)
+{
 	// Interp and set the In Air Lean Amount
 	const FALSLeanAmount& InAirLeanAmount = CalculateAirLeanAmount();
 	LeanAmount.LR = FMath::FInterpTo(LeanAmount.LR, InAirLeanAmount.LR, DeltaSeconds, Config.GroundedLeanInterpSpeed);
@@ -609,10 +1071,20 @@ void UALSCharacterAnimInstance::UpdateRagdollValues()
 	FlailRate = FMath::GetMappedRangeValueClamped({0.0f, 1000.0f}, {0.0f, 1.0f}, VelocityLength);
 }
 
-float UALSCharacterAnimInstance::GetAnimCurveClamped(const FName& Name, const float Bias, const float ClampMin,
-													 const float ClampMax) const
+float UALSCharacterAnimInstance::GetAnimCurveClamped(const float CurveValue, const float Bias, const float ClampMin,
+													 const float ClampMax)
+{
+	return FALSLocomotionCore::GetAnimCurveClamped(CurveValue, Bias, ClampMin, ClampMax);
+}
+
+FALSAnimatedSpeeds UALSCharacterAnimInstance::GetAnimatedSpeeds() const
 {
-	return FMath::Clamp(GetCurveValue(Name) + Bias, ClampMin, ClampMax);
+	FALSAnimatedSpeeds AnimatedSpeeds;
+	AnimatedSpeeds.WalkSpeed = Config.AnimatedWalkSpeed;
+	AnimatedSpeeds.RunSpeed = Config.AnimatedRunSpeed;
+	AnimatedSpeeds.SprintSpeed = Config.AnimatedSprintSpeed;
+	AnimatedSpeeds.CrouchSpeed = Config.AnimatedCrouchSpeed;
+	return AnimatedSpeeds;
 }
 
 FALSVelocityBlend UALSCharacterAnimInstance::CalculateVelocityBlend() const
@@ -622,14 +1094,13 @@ FALSVelocityBlend UALSCharacterAnimInstance::CalculateVelocityBlend() const
 	// directional blending than a standard blendspace.
 	const FVector LocRelativeVelocityDir =
 		CharacterInformation.CharacterActorRotation.UnrotateVector(CharacterInformation.Velocity.GetSafeNormal(0.1f));
-	const float Sum = FMath::Abs(LocRelativeVelocityDir.X) + FMath::Abs(LocRelativeVelocityDir.Y) +
-		FMath::Abs(LocRelativeVelocityDir.Z);
-	const FVector RelativeDir = LocRelativeVelocityDir / Sum;
+	const FALSDirectionalBlend Blend =
+		FALSLocomotionCore::CalculateVelocityBlend(ALSLocomotionCore::ToCore(LocRelativeVelocityDir));
 	FALSVelocityBlend Result;
-	Result.F = FMath::Clamp(RelativeDir.X, 0.0f, 1.0f);
-	Result.B = FMath::Abs(FMath::Clamp(RelativeDir.X, -1.0f, 0.0f));
-	Result.L = FMath::Abs(FMath::Clamp(RelativeDir.Y, -1.0f, 0.0f));
-	Result.R = FMath::Clamp(RelativeDir.Y, 0.0f, 1.0f);
+	Result.F = Blend.F;
+	Result.B = Blend.B;
+	Result.L = Blend.L;
+	Result.R = Blend.R;
 	return Result;
 }
 
@@ -638,16 +1109,11 @@ FVector UALSCharacterAnimInstance::CalculateRelativeAccelerationAmount() const
 	// Calculate the Relative Acceleration Amount. This value represents the current amount of acceleration / deceleration
 	// relative to the actor rotation. It is normalized to a range of -1 to 1 so that -1 equals the Max Braking Deceleration,
 	// and 1 equals the Max Acceleration of the Character Movement Component.
-	if (FVector::DotProduct(CharacterInformation.Acceleration, CharacterInformation.Velocity) > 0.0f)
-	{
-		const float MaxAcc = Character->GetCharacterMovement()->GetMaxAcceleration();
-		return CharacterInformation.CharacterActorRotation.UnrotateVector(
-			CharacterInformation.Acceleration.GetClampedToMaxSize(MaxAcc) / MaxAcc);
-	}
-
-	const float MaxBrakingDec = Character->GetCharacterMovement()->GetMaxBrakingDeceleration();
-	return CharacterInformation.CharacterActorRotation.UnrotateVector(
-		CharacterInformation.Acceleration.GetClampedToMaxSize(MaxBrakingDec) / MaxBrakingDec);
+	const FALSCoreVector AccelerationAmount = FALSLocomotionCore::CalculateAccelerationAmount(
+		ALSLocomotionCore::ToCore(CharacterInformation.Acceleration),
+		ALSLocomotionCore::ToCore(CharacterInformation.Velocity), CharacterInformation.MaxAcceleration,
+		CharacterInformation.MaxBrakingDeceleration);
+	return CharacterInformation.CharacterActorRotation.UnrotateVector(ALSLocomotionCore::FromCore(AccelerationAmount));
 }
 
 float UALSCharacterAnimInstance::CalculateStrideBlend() const
@@ -657,14 +1123,12 @@ float UALSCharacterAnimInstance::CalculateStrideBlend() const
 	// It also allows the walk or run gait animations to blend independently while still matching the animation speed to
 	// the movement speed, preventing the character from needing to play a half walk+half run blend.
 	// The curves are used to map the stride amount to the speed for maximum control.
-	const float CurveTime = CharacterInformation.Speed / GetOwningComponent()->GetComponentScale().Z;
-	const float ClampedGait = GetAnimCurveClamped(FName(TEXT("Weight_Gait")), -1.0, 0.0f, 1.0f);
-	const float LerpedStrideBlend = FMath::Lerp(StrideBlend_N_Walk->GetFloatValue(CurveTime),
-												StrideBlend_N_Run->GetFloatValue(CurveTime),
-												ClampedGait);
-	return FMath::Lerp(LerpedStrideBlend,
-					   StrideBlend_C_Walk->GetFloatValue(CharacterInformation.Speed),
-					   GetCurveValue(FName(TEXT("BasePose_CLF"))));
+	const float CurveTime = CharacterInformation.Speed / CharacterInformation.MeshScale;
+	return FALSLocomotionCore::CalculateStrideBlend(
+		UALSCurveCacheSubsystem::GetFloatValue(StrideBlend_N_Walk, BakedStrideBlend_N_Walk, CurveTime),
+		UALSCurveCacheSubsystem::GetFloatValue(StrideBlend_N_Run, BakedStrideBlend_N_Run, CurveTime),
+		UALSCurveCacheSubsystem::GetFloatValue(StrideBlend_C_Walk, BakedStrideBlend_C_Walk, CharacterInformation.Speed),
+		CurveValues.Weight_Gait, CurveValues.BasePose_CLF);
 }
 
 float UALSCharacterAnimInstance::CalculateWalkRunBlend() const
@@ -679,17 +1143,9 @@ float UALSCharacterAnimInstance::CalculateStandingPlayRate() const
 	// The lerps are determined by the "Weight_Gait" anim curve that exists on every locomotion cycle so
 	// that the play rate is always in sync with the currently blended animation.
 	// The value is also divided by the Stride Blend and the mesh scale so that the play rate increases as the stride or scale gets smaller
-	const float LerpedSpeed = FMath::Lerp(CharacterInformation.Speed / Config.AnimatedWalkSpeed,
-										  CharacterInformation.Speed / Config.AnimatedRunSpeed,
-										  GetAnimCurveClamped(FName(TEXT("Weight_Gait")), -1.0f, 0.0f, 1.0f));
-
-	const float SprintAffectedSpeed = FMath::Lerp(LerpedSpeed,
-												  CharacterInformation.Speed / Config.AnimatedSprintSpeed,
-												  GetAnimCurveClamped(FName(TEXT("Weight_Gait")), -2.0f, 0.0f, 1.0f));
-
-	return FMath::Clamp((SprintAffectedSpeed / Grounded.StrideBlend) / GetOwningComponent()->GetComponentScale().Z,
-						0.0f,
-						3.0f);
+	return FALSLocomotionCore::CalculateStandingPlayRate(CharacterInformation.Speed, GetAnimatedSpeeds(),
+														 CurveValues.Weight_Gait, Grounded.StrideBlend,
+														 CharacterInformation.MeshScale);
 }
 
 float UALSCharacterAnimInstance::CalculateDiagonalScaleAmount() const
@@ -697,29 +1153,34 @@ float UALSCharacterAnimInstance::CalculateDiagonalScaleAmount() const
 	// Calculate the Diagnal Scale Amount. This value is used to scale the Foot IK Root bone to make the Foot IK bones
 	// cover more distance on the diagonal blends. Without scaling, the feet would not move far enough on the diagonal
 	// direction due to the linear translational blending of the IK bones. The curve is used to easily map the value.
-	return DiagonalScaleAmountCurve->GetFloatValue(FMath::Abs(VelocityBlend.F + VelocityBlend.B));
+	return UALSCurveCacheSubsystem::GetFloatValue(DiagonalScaleAmountCurve, BakedDiagonalScaleAmountCurve,
+												  FMath::Abs(VelocityBlend.F + VelocityBlend.B));
 }
 
 float UALSCharacterAnimInstance::CalculateCrouchingPlayRate() const
 {
 	// Calculate the Crouching Play Rate by dividing the Character's speed by the Animated Speed.
 	// This value needs to be separate from the standing play rate to improve the blend from crocuh to stand while in motion.
-	return FMath::Clamp(
-		CharacterInformation.Speed / Config.AnimatedCrouchSpeed / Grounded.StrideBlend / GetOwningComponent()->
-		GetComponentScale().Z,
-		0.0f,
-		2.0f);
+	return FALSLocomotionCore::CalculateCrouchingPlayRate(CharacterInformation.Speed, GetAnimatedSpeeds(),
+														  Grounded.StrideBlend, CharacterInformation.MeshScale);
 }
 
-float UALSCharacterAnimInstance::CalculateLandPrediction() const
+float UALSCharacterAnimInstance::CalculateLandPrediction()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CalculateLandPrediction);
+	CSV_SCOPED_TIMING_STAT(ALS, CalculateLandPrediction);
+
 	// Calculate the land prediction weight by tracing in the velocity direction to find a walkable surface the character
 	// is falling toward, and getting the 'Time' (range of 0-1, 1 being maximum, 0 being about to land) till impact.
 	// The Land Prediction Curve is used to control how the time affects the final weight for a smooth blend. 
-	if (InAir.FallSpeed >= -200.0f) { return 0.0f; }
+	if (InAir.FallSpeed >= -200.0f)
+	{
+		// Don't carry a cached sweep over to the next fall
+		LandPredictionSweep.bHasResult = false;
+		return 0.0f;
+	}
 
-	const UCapsuleComponent* CapsuleComp = Character->GetCapsuleComponent();
-	const FVector& CapsuleWorldLoc = CapsuleComp->GetComponentLocation();
+	const FVector& CapsuleWorldLoc = Character->GetCapsuleComponent()->GetComponentLocation();
 	const float VelocityZ = CharacterInformation.Velocity.Z;
 	FVector VelocityClamped = CharacterInformation.Velocity;
 	VelocityClamped.Z = FMath::Clamp(VelocityZ, -4000.0f, -200.0f);
@@ -730,31 +1191,120 @@ float UALSCharacterAnimInstance::CalculateLandPrediction() const
 		{50.0f, 2000.0f},
 		VelocityZ);
 
+	FHitResult HitResult;
+	const float Weight = SweepLandPrediction(CapsuleWorldLoc, TraceLength, Config.bUseAsyncLandPrediction, HitResult)
+							 ? GetLandPredictionWeight(HitResult)
+							 : 0.0f;
+
+#if !UE_BUILD_SHIPPING
+	// Check the async weight against the one of the synchronous sweep
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	if (Config.bUseAsyncLandPrediction && Settings->bVerifyAsyncLandPrediction)
+	{
+		FHitResult SyncHitResult;
+		SweepLandPrediction(CapsuleWorldLoc, TraceLength, false, SyncHitResult);
+		FALSStats::RecordLandPredictionDeviation(FMath::Abs(Weight - GetLandPredictionWeight(SyncHitResult)),
+												 Settings->AsyncLandPredictionTolerance);
+	}
+#endif
+
+	return Weight;
+}
+
+float UALSCharacterAnimInstance::GetLandPredictionWeight(const FHitResult& HitResult) const
+{
+	if (!Character->GetCharacterMovement()->IsWalkable(HitResult)) { return 0.0f; }
+
+	return FMath::Lerp(UALSCurveCacheSubsystem::GetFloatValue(LandPredictionCurve, BakedLandPredictionCurve,
+															  HitResult.Time),
+					   0.0f,
+					   CurveValues.Mask_LandPrediction);
+}
+
+bool UALSCharacterAnimInstance::SweepLandPrediction(const FVector& Start, const FVector& TraceLength, const bool bAsync,
+													FHitResult& OutHitResult)
+{
 	UWorld* World = GetWorld();
 	check(World);
 
+	const UCapsuleComponent* CapsuleComp = Character->GetCapsuleComponent();
+	const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(CapsuleComp->GetUnscaledCapsuleRadius(),
+																	  CapsuleComp->GetUnscaledCapsuleHalfHeight());
+
 	FCollisionQueryParams Params;
 	Params.AddIgnoredActor(Character);
 
-	FHitResult HitResult;
+	if (!bAsync)
+	{
+		FALSStats::CountSceneQuery();
+		World->SweepSingleByProfile(OutHitResult, Start, Start + TraceLength, FQuat::Identity,
+									FName(TEXT("ALS_Character")), CapsuleShape, Params);
+		return true;
+	}
 
-	World->SweepSingleByProfile(HitResult,
-								CapsuleWorldLoc,
-								CapsuleWorldLoc + TraceLength,
-								FQuat::Identity,
-								FName(TEXT("ALS_Character")),
-								FCollisionShape::MakeCapsule(CapsuleComp->GetUnscaledCapsuleRadius(),
-															 CapsuleComp->GetUnscaledCapsuleHalfHeight()),
-								Params);
+	FALSLandPredictionSweep& Sweep = LandPredictionSweep;
 
-	if (Character->GetCharacterMovement()->IsWalkable(HitResult))
+	// Step 1: Consume the result of the sweep submitted in the last frame. Drop the handle if its data is already gone.
+	if (Sweep.Handle.IsValid())
 	{
-		return FMath::Lerp(LandPredictionCurve->GetFloatValue(HitResult.Time),
-						   0.0f,
-						   GetCurveValue(FName(TEXT("Mask_LandPrediction"))));
+		FTraceDatum TraceDatum;
+		if (World->QueryTraceData(Sweep.Handle, TraceDatum))
+		{
+			Sweep.HitResult = TraceDatum.OutHits.Num() > 0 ? TraceDatum.OutHits[0] : FHitResult();
+			Sweep.SweepStart = Sweep.PendingStart;
+			Sweep.SweepEnd = Sweep.PendingEnd;
+			Sweep.bHasResult = true;
+			Sweep.Handle.Invalidate();
+		}
+		else if (!World->IsTraceHandleValid(Sweep.Handle, false)) { Sweep.Handle.Invalidate(); }
+	}
+
+	// Step 2: Re-sweep only if the trajectory changed meaningfully since the last sweep: the fall direction turned,
+	// the character drifted sideways off the swept path, or the current trace reaches past a sweep that didn't hit.
+	const float Length = TraceLength.Size();
+	const FVector Direction = TraceLength / Length;
+	bool bShouldSweep = !Sweep.bHasResult;
+	if (Sweep.bHasResult)
+	{
+		const FVector SweepVector = Sweep.SweepEnd - Sweep.SweepStart;
+		const float SweepLength = SweepVector.Size();
+		const FVector SweepDirection = SweepVector / SweepLength;
+		const FVector Offset = Start - Sweep.SweepStart;
+		const float ResweepCos = FMath::Cos(FMath::DegreesToRadians(Config.LandPredictionResweepAngle));
+
+		bShouldSweep = FVector::DotProduct(Direction, SweepDirection) < ResweepCos ||
+			(Offset - SweepDirection * FVector::DotProduct(Offset, SweepDirection)).Size() >
+			Config.LandPredictionResweepDistance ||
+			(!Sweep.HitResult.bBlockingHit &&
+				FVector::DotProduct(Offset + TraceLength, SweepDirection) >
+				SweepLength + Config.LandPredictionResweepDistance);
+	}
+
+	if (bShouldSweep && !Sweep.Handle.IsValid())
+	{
+		FALSStats::CountSceneQuery();
+		Sweep.Handle = World->AsyncSweepByProfile(EAsyncTraceType::Single, Start, Start + TraceLength, FQuat::Identity,
+												  FName(TEXT("ALS_Character")), CapsuleShape, Params);
+		Sweep.PendingStart = Start;
+		Sweep.PendingEnd = Start + TraceLength;
 	}
 
-	return 0.0f;
+	if (!Sweep.bHasResult) { return false; }
+
+	// Step 3: Extrapolate the hit time from the current location and trace length. A hit that is out of reach
+	// of the current trace is treated the same way as the synchronous sweep would, as no hit.
+	OutHitResult = Sweep.HitResult;
+	if (OutHitResult.bBlockingHit)
+	{
+		const float Remaining = FVector::DotProduct(OutHitResult.Location - Start, Direction);
+		if (Remaining > Length)
+		{
+			OutHitResult.bBlockingHit = false;
+			OutHitResult.Time = 1.0f;
+		}
+		else { OutHitResult.Time = FMath::Clamp(Remaining / Length, 0.0f, 1.0f); }
+	}
+	return true;
 }
 
 FALSLeanAmount UALSCharacterAnimInstance::CalculateAirLeanAmount() const
@@ -762,13 +1312,13 @@ FALSLeanAmount UALSCharacterAnimInstance::CalculateAirLeanAmount() const
 	// Use the relative Velocity direction and amount to determine how much the character should lean while in air.
 	// The Lean In Air curve gets the Fall Speed and is used as a multiplier to smoothly reverse the leaning direction
 	// when transitioning from moving upwards to moving downwards.
+	const FVector UnrotatedVel = CharacterInformation.CharacterActorRotation.UnrotateVector(CharacterInformation.Velocity);
+	const FALSLeanValues Lean = FALSLocomotionCore::CalculateAirLeanAmount(
+		UnrotatedVel.X, UnrotatedVel.Y,
+		UALSCurveCacheSubsystem::GetFloatValue(LeanInAirCurve, BakedLeanInAirCurve, InAir.FallSpeed));
 	FALSLeanAmount CalcLeanAmount;
-	const FVector& UnrotatedVel = CharacterInformation.CharacterActorRotation.UnrotateVector(
-		CharacterInformation.Velocity) / 350.0f;
-	FVector2D InversedVect(UnrotatedVel.Y, UnrotatedVel.X);
-	InversedVect *= LeanInAirCurve->GetFloatValue(InAir.FallSpeed);
-	CalcLeanAmount.LR = InversedVect.X;
-	CalcLeanAmount.FB = InversedVect.Y;
+	CalcLeanAmount.LR = Lean.LR;
+	CalcLeanAmount.FB = Lean.FB;
 	return CalcLeanAmount;
 }
 
@@ -781,7 +1331,8 @@ EALSMovementDirection UALSCharacterAnimInstance::CalculateMovementDirection() co
 
 	FRotator Delta = CharacterInformation.Velocity.ToOrientationRotator() - CharacterInformation.AimingRotation;
 	Delta.Normalize();
-	return UALSMathLibrary::CalculateQuadrant(MovementDirection, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Delta.Yaw);
+	return ALSLocomotionCore::FromCore(FALSLocomotionCore::CalculateQuadrant(
+		ALSLocomotionCore::ToCore(MovementDirection), 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Delta.Yaw));
 }
 
 void UALSCharacterAnimInstance::TurnInPlace(const FRotator TargetRotation, const float PlayRateScale,
@@ -0,0 +1,330 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/ALSLocomotionBatchSubsystem.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Character/ALSCharacterTickSubsystem.h"
+#include "Library/ALSCurveCache.h"
+#include "Library/ALSStats.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+void FALSLocomotionBatchTickFunction::ExecuteTick(const float DeltaTime, ELevelTick TickType,
+												  ENamedThreads::Type CurrentThread,
+												  const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target) { Target->ExecuteBatch(DeltaTime); }
+}
+
+FString FALSLocomotionBatchTickFunction::DiagnosticMessage()
+{
+	return TEXT("FALSLocomotionBatchTickFunction");
+}
+
+void FALSLocomotionBatchData::Reset(const int32 Count)
+{
+	Num = Count;
+	const int32 PaddedNum = Align(Count, 4);
+	for (FLane* Lane : {
+			 &DeltaSeconds, &VelocityX, &VelocityY, &VelocityZ, &AccelerationX, &AccelerationY, &AccelerationZ,
+			 &AxisXX, &AxisXY, &AxisXZ, &AxisYX, &AxisYY, &AxisYZ, &AxisZX, &AxisZY, &AxisZZ,
+			 &MaxAcceleration, &MaxBrakingDeceleration, &Speed, &MeshScale, &StrideBlend, &WeightGait,
+			 &AnimatedWalkSpeed, &AnimatedRunSpeed, &AnimatedSprintSpeed, &AnimatedCrouchSpeed,
+			 &VelocityBlendInterpSpeed, &GroundedLeanInterpSpeed, &BlendF, &BlendB, &BlendL, &BlendR, &LeanLR, &LeanFB,
+			 &RelativeAccelerationX, &RelativeAccelerationY, &RelativeAccelerationZ, &StandingPlayRate, &CrouchingPlayRate
+		 })
+	{
+		// Padding lanes use 1, so that they never divide by zero
+		Lane->Init(1.0f, PaddedNum);
+	}
+}
+
+void UALSLocomotionBatchSubsystem::Deinitialize()
+{
+	if (BatchTickFunction.IsTickFunctionRegistered()) { BatchTickFunction.UnRegisterTickFunction(); }
+	AnimInstances.Empty();
+	BatchedInstances.Empty();
+	Super::Deinitialize();
+}
+
+void UALSLocomotionBatchSubsystem::RegisterAnimInstance(UALSCharacterAnimInstance* AnimInstance)
+{
+	AALSBaseCharacter* Character = AnimInstance ? AnimInstance->Character : nullptr;
+	if (!Character) { return; }
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	if (!BatchTickFunction.IsTickFunctionRegistered())
+	{
+		BatchTickFunction.Target = this;
+		BatchTickFunction.bCanEverTick = true;
+		BatchTickFunction.TickGroup = TG_PrePhysics;
+		BatchTickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+
+	// The batch needs the values of this frame's character and movement update,
+	// and the mesh needs the batch results before updating its anim instance.
+	BatchTickFunction.AddPrerequisite(Character, Character->PrimaryActorTick);
+	UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
+	BatchTickFunction.AddPrerequisite(MovementComp, MovementComp->PrimaryComponentTick);
+	// Characters may be ticked by the batched character tick instead of their actor tick
+	UALSCharacterTickSubsystem* CharacterTickSubsystem = World->GetSubsystem<UALSCharacterTickSubsystem>();
+	if (CharacterTickSubsystem) { BatchTickFunction.AddPrerequisite(CharacterTickSubsystem, CharacterTickSubsystem->GetTickFunction()); }
+	AnimInstance->GetOwningComponent()->PrimaryComponentTick.AddPrerequisite(this, BatchTickFunction);
+
+	AnimInstances.AddUnique(AnimInstance);
+}
+
+void UALSLocomotionBatchSubsystem::UnregisterAnimInstance(UALSCharacterAnimInstance* AnimInstance)
+{
+	if (!AnimInstance) { return; }
+
+	AnimInstances.Remove(AnimInstance);
+	BatchedInstances.Remove(AnimInstance);
+
+	if (AALSBaseCharacter* Character = AnimInstance->Character)
+	{
+		BatchTickFunction.RemovePrerequisite(Character, Character->PrimaryActorTick);
+		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
+		BatchTickFunction.RemovePrerequisite(MovementComp, MovementComp->PrimaryComponentTick);
+	}
+	AnimInstance->GetOwningComponent()->PrimaryComponentTick.RemovePrerequisite(this, BatchTickFunction);
+}
+
+void UALSLocomotionBatchSubsystem::ExecuteBatch(const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_LocomotionBatch);
+	CSV_SCOPED_TIMING_STAT(ALS, LocomotionBatch);
+
+	// Step 1: Collect the anim instances which run the grounded movement update in this frame.
+	// Instances updating at a reduced anim LOD rate use their own update, since their delta time differs.
+	BatchedInstances.Reset();
+	AnimInstances.RemoveAll([](const TWeakObjectPtr<UALSCharacterAnimInstance>& AnimInstance)
+	{
+		return !AnimInstance.IsValid();
+	});
+	for (const TWeakObjectPtr<UALSCharacterAnimInstance>& AnimInstance : AnimInstances)
+	{
+		// The characters already published this frame's state, swap it in early so the batch reads the same values
+		if (AnimInstance->Character) { AnimInstance->ConsumeCharacterInformation(); }
+		if (AnimInstance->Character && AnimInstance->MovementState.Grounded() &&
+			AnimInstance->AnimLODFeatures.UpdateInterval <= 1)
+		{
+			BatchedInstances.Add(AnimInstance.Get());
+		}
+	}
+
+	if (BatchedInstances.Num() == 0) { return; }
+
+	// Step 2: Gather the inputs into the batch lanes.
+	BatchData.Reset(BatchedInstances.Num());
+	for (int32 Index = 0; Index < BatchedInstances.Num(); ++Index)
+	{
+		UALSCharacterAnimInstance* AnimInstance = BatchedInstances[Index];
+		const AALSBaseCharacter* Character = AnimInstance->Character;
+		const USkeletalMeshComponent* Mesh = AnimInstance->GetOwningComponent();
+		const FALSAnimCharacterInformation& CharacterInformation = AnimInstance->CharacterInformation;
+		const FALSAnimConfiguration& Config = AnimInstance->Config;
+
+		AnimInstance->UpdateCurveValues();
+
+		const FVector& Velocity = CharacterInformation.Velocity;
+		const FVector& Acceleration = CharacterInformation.Acceleration;
+		const FRotationMatrix Rotation(CharacterInformation.CharacterActorRotation);
+		const FVector AxisX = Rotation.GetScaledAxis(EAxis::X);
+		const FVector AxisY = Rotation.GetScaledAxis(EAxis::Y);
+		const FVector AxisZ = Rotation.GetScaledAxis(EAxis::Z);
+
+		BatchData.DeltaSeconds[Index] = DeltaTime * Character->CustomTimeDilation * Mesh->GlobalAnimRateScale;
+		BatchData.VelocityX[Index] = Velocity.X;
+		BatchData.VelocityY[Index] = Velocity.Y;
+		BatchData.VelocityZ[Index] = Velocity.Z;
+		BatchData.AccelerationX[Index] = Acceleration.X;
+		BatchData.AccelerationY[Index] = Acceleration.Y;
+		BatchData.AccelerationZ[Index] = Acceleration.Z;
+		BatchData.AxisXX[Index] = AxisX.X;
+		BatchData.AxisXY[Index] = AxisX.Y;
+		BatchData.AxisXZ[Index] = AxisX.Z;
+		BatchData.AxisYX[Index] = AxisY.X;
+		BatchData.AxisYY[Index] = AxisY.Y;
+		BatchData.AxisYZ[Index] = AxisY.Z;
+		BatchData.AxisZX[Index] = AxisZ.X;
+		BatchData.AxisZY[Index] = AxisZ.Y;
+		BatchData.AxisZZ[Index] = AxisZ.Z;
+		BatchData.MaxAcceleration[Index] = CharacterInformation.MaxAcceleration;
+		BatchData.MaxBrakingDeceleration[Index] = CharacterInformation.MaxBrakingDeceleration;
+		BatchData.Speed[Index] = CharacterInformation.Speed;
+		BatchData.MeshScale[Index] = CharacterInformation.MeshScale;
+		BatchData.StrideBlend[Index] = AnimInstance->CalculateStrideBlend();
+		BatchData.WeightGait[Index] = AnimInstance->CurveValues.Weight_Gait;
+		BatchData.AnimatedWalkSpeed[Index] = Config.AnimatedWalkSpeed;
+		BatchData.AnimatedRunSpeed[Index] = Config.AnimatedRunSpeed;
+		BatchData.AnimatedSprintSpeed[Index] = Config.AnimatedSprintSpeed;
+		BatchData.AnimatedCrouchSpeed[Index] = Config.AnimatedCrouchSpeed;
+		BatchData.VelocityBlendInterpSpeed[Index] = Config.VelocityBlendInterpSpeed;
+		BatchData.GroundedLeanInterpSpeed[Index] = Config.GroundedLeanInterpSpeed;
+		BatchData.BlendF[Index] = AnimInstance->VelocityBlend.F;
+		BatchData.BlendB[Index] = AnimInstance->VelocityBlend.B;
+		BatchData.BlendL[Index] = AnimInstance->VelocityBlend.L;
+		BatchData.BlendR[Index] = AnimInstance->VelocityBlend.R;
+		BatchData.LeanLR[Index] = AnimInstance->LeanAmount.LR;
+		BatchData.LeanFB[Index] = AnimInstance->LeanAmount.FB;
+	}
+
+	// Step 3: Run the kernel on all characters at once.
+	RunKernel(BatchData);
+
+	// Step 4: Scatter the results back. They're only applied by the anim instance if it runs the grounded movement
+	// update in this frame with the same delta time, otherwise they're discarded.
+	for (int32 Index = 0; Index < BatchedInstances.Num(); ++Index)
+	{
+		UALSCharacterAnimInstance* AnimInstance = BatchedInstances[Index];
+		FALSBatchedMovementValues& Values = AnimInstance->BatchedMovementValues;
+		Values.FrameCounter = GFrameCounter;
+		Values.DeltaSeconds = BatchData.DeltaSeconds[Index];
+		Values.VelocityBlend.F = BatchData.BlendF[Index];
+		Values.VelocityBlend.B = BatchData.BlendB[Index];
+		Values.VelocityBlend.L = BatchData.BlendL[Index];
+		Values.VelocityBlend.R = BatchData.BlendR[Index];
+		Values.RelativeAccelerationAmount.X = BatchData.RelativeAccelerationX[Index];
+		Values.RelativeAccelerationAmount.Y = BatchData.RelativeAccelerationY[Index];
+		Values.RelativeAccelerationAmount.Z = BatchData.RelativeAccelerationZ[Index];
+		Values.LeanAmount.LR = BatchData.LeanLR[Index];
+		Values.LeanAmount.FB = BatchData.LeanFB[Index];
+		Values.StrideBlend = BatchData.StrideBlend[Index];
+		Values.StandingPlayRate = BatchData.StandingPlayRate[Index];
+		Values.CrouchingPlayRate = BatchData.CrouchingPlayRate[Index];
+		Values.DiagonalScaleAmount = UALSCurveCacheSubsystem::GetFloatValue(
+			AnimInstance->DiagonalScaleAmountCurve, AnimInstance->BakedDiagonalScaleAmountCurve,
+			FMath::Abs(Values.VelocityBlend.F + Values.VelocityBlend.B));
+	}
+}
+
+static FORCEINLINE VectorRegister ClampVector(const VectorRegister& Value, const VectorRegister& Min,
+											  const VectorRegister& Max)
+{
+	return VectorMin(VectorMax(Value, Min), Max);
+}
+
+static FORCEINLINE VectorRegister InterpAlpha(const VectorRegister& DeltaSeconds, const VectorRegister& InterpSpeed)
+{
+	// FMath::FInterpTo returns the target directly if the interp speed is not positive
+	const VectorRegister Alpha = ClampVector(VectorMultiply(DeltaSeconds, InterpSpeed), VectorZero(), VectorOne());
+	return VectorSelect(VectorCompareGT(InterpSpeed, VectorZero()), Alpha, VectorOne());
+}
+
+static FORCEINLINE VectorRegister InterpTo(const VectorRegister& Current, const VectorRegister& Target,
+										   const VectorRegister& Alpha)
+{
+	// Same as FMath::FInterpTo, snapping to the target once the distance is negligible
+	const VectorRegister Distance = VectorSubtract(Target, Current);
+	const VectorRegister bSnap = VectorCompareGT(VectorSetFloat1(SMALL_NUMBER), VectorMultiply(Distance, Distance));
+	return VectorSelect(bSnap, Target, VectorMultiplyAdd(Distance, Alpha, Current));
+}
+
+static FORCEINLINE VectorRegister Dot3(const VectorRegister& AX, const VectorRegister& AY, const VectorRegister& AZ,
+									   const VectorRegister& BX, const VectorRegister& BY, const VectorRegister& BZ)
+{
+	return VectorMultiplyAdd(AX, BX, VectorMultiplyAdd(AY, BY, VectorMultiply(AZ, BZ)));
+}
+
+void UALSLocomotionBatchSubsystem::RunKernel(FALSLocomotionBatchData& Data)
+{
+	const VectorRegister Zero = VectorZero();
+	const VectorRegister One = VectorOne();
+	const VectorRegister Tiny = VectorSetFloat1(SMALL_NUMBER);
+
+	for (int32 Index = 0; Index < Data.Num; Index += 4)
+	{
+		const auto Load = [Index](const FALSLocomotionBatchData::FLane& Lane)
+		{
+			return VectorLoadAligned(Lane.GetData() + Index);
+		};
+		const auto Store = [Index](FALSLocomotionBatchData::FLane& Lane, const VectorRegister& Value)
+		{
+			VectorStoreAligned(Value, Lane.GetData() + Index);
+		};
+
+		const VectorRegister DeltaSeconds = Load(Data.DeltaSeconds);
+		const VectorRegister VelX = Load(Data.VelocityX);
+		const VectorRegister VelY = Load(Data.VelocityY);
+		const VectorRegister VelZ = Load(Data.VelocityZ);
+		const VectorRegister AccX = Load(Data.AccelerationX);
+		const VectorRegister AccY = Load(Data.AccelerationY);
+		const VectorRegister AccZ = Load(Data.AccelerationZ);
+		const VectorRegister AxXX = Load(Data.AxisXX), AxXY = Load(Data.AxisXY), AxXZ = Load(Data.AxisXZ);
+		const VectorRegister AxYX = Load(Data.AxisYX), AxYY = Load(Data.AxisYY), AxYZ = Load(Data.AxisYZ);
+		const VectorRegister AxZX = Load(Data.AxisZX), AxZY = Load(Data.AxisZY), AxZZ = Load(Data.AxisZZ);
+
+		// Step 1: Velocity Blend, see UALSCharacterAnimInstance::CalculateVelocityBlend.
+		// Velocity.GetSafeNormal(0.1f) unrotated by the actor rotation, normalized so that diagonals equal .5.
+		const VectorRegister VelSizeSquared = Dot3(VelX, VelY, VelZ, VelX, VelY, VelZ);
+		const VectorRegister bHasVelocity = VectorCompareGT(VelSizeSquared, VectorSetFloat1(0.1f));
+		const VectorRegister VelScale = VectorSelect(bHasVelocity,
+													 VectorReciprocalSqrtAccurate(VectorMax(VelSizeSquared, Tiny)),
+													 Zero);
+		const VectorRegister DirX = VectorMultiply(VelX, VelScale);
+		const VectorRegister DirY = VectorMultiply(VelY, VelScale);
+		const VectorRegister DirZ = VectorMultiply(VelZ, VelScale);
+		const VectorRegister LocalX = Dot3(DirX, DirY, DirZ, AxXX, AxXY, AxXZ);
+		const VectorRegister LocalY = Dot3(DirX, DirY, DirZ, AxYX, AxYY, AxYZ);
+		const VectorRegister LocalZ = Dot3(DirX, DirY, DirZ, AxZX, AxZY, AxZZ);
+		const VectorRegister Sum = VectorAdd(VectorAdd(VectorAbs(LocalX), VectorAbs(LocalY)), VectorAbs(LocalZ));
+		const VectorRegister InvSum = VectorReciprocalAccurate(VectorMax(Sum, Tiny));
+		const VectorRegister RelativeX = VectorMultiply(LocalX, InvSum);
+		const VectorRegister RelativeY = VectorMultiply(LocalY, InvSum);
+
+		const VectorRegister BlendAlpha = InterpAlpha(DeltaSeconds, Load(Data.VelocityBlendInterpSpeed));
+		Store(Data.BlendF, InterpTo(Load(Data.BlendF), ClampVector(RelativeX, Zero, One), BlendAlpha));
+		Store(Data.BlendB, InterpTo(Load(Data.BlendB), ClampVector(VectorNegate(RelativeX), Zero, One), BlendAlpha));
+		Store(Data.BlendL, InterpTo(Load(Data.BlendL), ClampVector(VectorNegate(RelativeY), Zero, One), BlendAlpha));
+		Store(Data.BlendR, InterpTo(Load(Data.BlendR), ClampVector(RelativeY, Zero, One), BlendAlpha));
+
+		// Step 2: Relative Acceleration Amount, see UALSCharacterAnimInstance::CalculateRelativeAccelerationAmount.
+		// Clamping the acceleration to the max value and dividing by it is a scale of min(1 / Max, 1 / Size).
+		const VectorRegister bAccelerating = VectorCompareGT(Dot3(AccX, AccY, AccZ, VelX, VelY, VelZ), Zero);
+		const VectorRegister MaxValue = VectorSelect(bAccelerating, Load(Data.MaxAcceleration),
+													 Load(Data.MaxBrakingDeceleration));
+		const VectorRegister AccSizeSquared = Dot3(AccX, AccY, AccZ, AccX, AccY, AccZ);
+		const VectorRegister AccScale = VectorMin(VectorReciprocalAccurate(VectorMax(MaxValue, Tiny)),
+												  VectorReciprocalSqrtAccurate(VectorMax(AccSizeSquared, Tiny)));
+		const VectorRegister ScaledAccX = VectorMultiply(AccX, AccScale);
+		const VectorRegister ScaledAccY = VectorMultiply(AccY, AccScale);
+		const VectorRegister ScaledAccZ = VectorMultiply(AccZ, AccScale);
+		const VectorRegister RelAccX = Dot3(ScaledAccX, ScaledAccY, ScaledAccZ, AxXX, AxXY, AxXZ);
+		const VectorRegister RelAccY = Dot3(ScaledAccX, ScaledAccY, ScaledAccZ, AxYX, AxYY, AxYZ);
+		const VectorRegister RelAccZ = Dot3(ScaledAccX, ScaledAccY, ScaledAccZ, AxZX, AxZY, AxZZ);
+		Store(Data.RelativeAccelerationX, RelAccX);
+		Store(Data.RelativeAccelerationY, RelAccY);
+		Store(Data.RelativeAccelerationZ, RelAccZ);
+
+		// Step 3: Interp the Lean Amount.
+		const VectorRegister LeanAlpha = InterpAlpha(DeltaSeconds, Load(Data.GroundedLeanInterpSpeed));
+		Store(Data.LeanLR, InterpTo(Load(Data.LeanLR), RelAccY, LeanAlpha));
+		Store(Data.LeanFB, InterpTo(Load(Data.LeanFB), RelAccX, LeanAlpha));
+
+		// Step 4: Standing and Crouching Play Rates, see UALSCharacterAnimInstance::CalculateStandingPlayRate.
+		const VectorRegister Speed = Load(Data.Speed);
+		const VectorRegister WeightGait = Load(Data.WeightGait);
+		const VectorRegister WalkRunAlpha = ClampVector(VectorSubtract(WeightGait, One), Zero, One);
+		const VectorRegister SprintAlpha = ClampVector(VectorSubtract(WeightGait, VectorSetFloat1(2.0f)), Zero, One);
+		const VectorRegister WalkRate = VectorDivide(Speed, Load(Data.AnimatedWalkSpeed));
+		const VectorRegister RunRate = VectorDivide(Speed, Load(Data.AnimatedRunSpeed));
+		const VectorRegister SprintRate = VectorDivide(Speed, Load(Data.AnimatedSprintSpeed));
+		const VectorRegister LerpedRate = VectorMultiplyAdd(VectorSubtract(RunRate, WalkRate), WalkRunAlpha, WalkRate);
+		const VectorRegister SprintAffectedRate = VectorMultiplyAdd(VectorSubtract(SprintRate, LerpedRate), SprintAlpha,
+																	LerpedRate);
+		const VectorRegister StrideScale = VectorMultiply(Load(Data.StrideBlend), Load(Data.MeshScale));
+		Store(Data.StandingPlayRate,
+			  ClampVector(VectorDivide(SprintAffectedRate, StrideScale), Zero, VectorSetFloat1(3.0f)));
+		Store(Data.CrouchingPlayRate,
+			  ClampVector(VectorDivide(VectorDivide(Speed, Load(Data.AnimatedCrouchSpeed)), StrideScale),
+						  Zero, VectorSetFloat1(2.0f)));
+	}
+}
@@ -0,0 +1,577 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSBenchmark.h"
+#include "ALS_Settings.h"
+#include "Character/ALSBaseCharacter.h"
+#include "AIController.h"
+#include "CoreGlobals.h"
+#include "EngineUtils.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY(LogAlsBenchmark)
+
+namespace ALSBenchmark
+{
+	/** Scripted behaviours, each character cycles through all of them */
+	enum class EPhase : uint8
+	{
+		Walking,
+		Sprinting,
+		Falling,
+		Flight,
+		Mantling,
+		Ragdoll,
+		Count
+	};
+
+	const TCHAR* PhaseNames[] = {
+		TEXT("Walking"), TEXT("Sprinting"), TEXT("Falling"), TEXT("Flight"), TEXT("Mantling"), TEXT("Ragdoll")
+	};
+	static_assert(UE_ARRAY_COUNT(PhaseNames) == static_cast<int32>(EPhase::Count), "Every phase needs a name");
+
+	/** Settings the benchmark can compare, see FALSBenchmarkOptions::Comparison */
+	const TCHAR* ComparisonNames[] = {TEXT("AnimWorker"), TEXT("CurveReads"), TEXT("ReplicationThresholds")};
+
+	/** Sets the compared settings to before the optimization (disabled) or after it (enabled) */
+	using FApplyComparison = void (*)(UALS_Settings& Settings, const FALSBenchmarkSettings& Initial, bool bEnabled);
+
+	const FApplyComparison ComparisonSettings[] = {
+		[](UALS_Settings& Settings, const FALSBenchmarkSettings&, const bool bEnabled)
+		{
+			Settings.bUseAnimWorkerUpdate = bEnabled;
+		},
+		[](UALS_Settings& Settings, const FALSBenchmarkSettings&, const bool bEnabled)
+		{
+			Settings.bReadAnimCurvesInOnePass = bEnabled;
+		},
+		// Without the thresholds every change replicates
+		[](UALS_Settings& Settings, const FALSBenchmarkSettings& Initial, const bool bEnabled)
+		{
+			Settings.ReplicatedAccelerationThreshold = bEnabled ? Initial.ReplicatedAccelerationThreshold : 0.0f;
+			Settings.ReplicatedControlRotationThreshold = bEnabled ? Initial.ReplicatedControlRotationThreshold : 0.0f;
+		}
+	};
+	static_assert(UE_ARRAY_COUNT(ComparisonNames) == UE_ARRAY_COUNT(ComparisonSettings), "Every comparison needs a setting");
+
+	FALSBenchmarkSettings SaveSettings(const UALS_Settings& Settings)
+	{
+		FALSBenchmarkSettings Saved;
+		Saved.bUseAnimWorkerUpdate = Settings.bUseAnimWorkerUpdate;
+		Saved.bReadAnimCurvesInOnePass = Settings.bReadAnimCurvesInOnePass;
+		Saved.ReplicatedAccelerationThreshold = Settings.ReplicatedAccelerationThreshold;
+		Saved.ReplicatedControlRotationThreshold = Settings.ReplicatedControlRotationThreshold;
+		return Saved;
+	}
+
+	void RestoreSettings(UALS_Settings& Settings, const FALSBenchmarkSettings& Saved)
+	{
+		Settings.bUseAnimWorkerUpdate = Saved.bUseAnimWorkerUpdate;
+		Settings.bReadAnimCurvesInOnePass = Saved.bReadAnimCurvesInOnePass;
+		Settings.ReplicatedAccelerationThreshold = Saved.ReplicatedAccelerationThreshold;
+		Settings.ReplicatedControlRotationThreshold = Saved.ReplicatedControlRotationThreshold;
+	}
+
+	constexpr float PhaseDuration = 2.0f;
+
+	constexpr float TurnRate = 45.0f;
+
+	constexpr float SpawnSpacing = 300.0f;
+
+	void WriteSampleStats(TJsonWriter<>& Writer, const TCHAR* Name, TArray<float> Samples)
+	{
+		Writer.WriteObjectStart(Name);
+		if (Samples.Num() > 0)
+		{
+			Samples.Sort();
+			float Sum = 0.0f;
+			for (const float Sample : Samples) { Sum += Sample; }
+
+			Writer.WriteValue(TEXT("Avg"), Sum / Samples.Num());
+			Writer.WriteValue(TEXT("Median"), Samples[Samples.Num() / 2]);
+			Writer.WriteValue(TEXT("P95"), Samples[FMath::Min(FMath::FloorToInt(Samples.Num() * 0.95f), Samples.Num() - 1)]);
+			Writer.WriteValue(TEXT("Max"), Samples.Last());
+		}
+		Writer.WriteObjectEnd();
+	}
+
+	float GetAverage(const TArray<float>& Samples)
+	{
+		float Sum = 0.0f;
+		for (const float Sample : Samples) { Sum += Sample; }
+		return Samples.Num() > 0 ? Sum / Samples.Num() : 0.0f;
+	}
+
+	void ExecuteBenchmarkCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			UE_LOG(LogAlsBenchmark, Warning, TEXT("ALS.Benchmark can only run in a game world"));
+			return;
+		}
+
+		FALSBenchmarkOptions Options;
+		FString ClassPath;
+		for (const FString& Arg : Args)
+		{
+			FString CountsValue;
+			FString PhaseValue;
+			FString ComparisonValue;
+			if (Arg.Equals(TEXT("Quit"), ESearchCase::IgnoreCase))
+			{
+				Options.bQuitWhenDone = true;
+			}
+			else if (FParse::Value(*Arg, TEXT("Counts="), CountsValue, false))
+			{
+				TArray<FString> Counts;
+				CountsValue.ParseIntoArray(Counts, TEXT(","));
+				Options.CharacterCounts.Reset();
+				for (const FString& Count : Counts) { Options.CharacterCounts.Add(FMath::Max(FCString::Atoi(*Count), 1)); }
+			}
+			else if (FParse::Value(*Arg, TEXT("Phase="), PhaseValue, false))
+			{
+				Options.Phase = INDEX_NONE;
+				for (int32 Index = 0; Index < static_cast<int32>(EPhase::Count); ++Index)
+				{
+					if (PhaseValue.Equals(PhaseNames[Index], ESearchCase::IgnoreCase)) { Options.Phase = Index; }
+				}
+				if (Options.Phase == INDEX_NONE) { UE_LOG(LogAlsBenchmark, Warning, TEXT("ALS.Benchmark: Unknown phase %s"), *PhaseValue); }
+			}
+			else if (FParse::Value(*Arg, TEXT("Compare="), ComparisonValue, false))
+			{
+				Options.Comparison = INDEX_NONE;
+				for (int32 Index = 0; Index < static_cast<int32>(UE_ARRAY_COUNT(ComparisonNames)); ++Index)
+				{
+					if (ComparisonValue.Equals(ComparisonNames[Index], ESearchCase::IgnoreCase)) { Options.Comparison = Index; }
+				}
+				if (Options.Comparison == INDEX_NONE)
+				{
+					UE_LOG(LogAlsBenchmark, Warning, TEXT("ALS.Benchmark: Unknown comparison %s"), *ComparisonValue);
+				}
+			}
+			else if (FParse::Value(*Arg, TEXT("Warmup="), Options.WarmupFrames)
+				|| FParse::Value(*Arg, TEXT("Frames="), Options.MeasuredFrames)
+				|| FParse::Value(*Arg, TEXT("Class="), ClassPath, false)
+				|| FParse::Value(*Arg, TEXT("Output="), Options.OutputPath, false))
+			{
+			}
+			else
+			{
+				UE_LOG(LogAlsBenchmark, Warning, TEXT("ALS.Benchmark: Unknown argument %s"), *Arg);
+			}
+		}
+
+		Options.WarmupFrames = FMath::Max(Options.WarmupFrames, 0);
+		Options.MeasuredFrames = FMath::Max(Options.MeasuredFrames, 1);
+
+		// Use the explicit class, then the one from the settings, then the default pawn if it's an ALS character
+		if (!ClassPath.IsEmpty()) { Options.CharacterClass = LoadClass<AALSBaseCharacter>(nullptr, *ClassPath); }
+		if (!Options.CharacterClass) { Options.CharacterClass = UALS_Settings::Get()->BenchmarkCharacterClass.LoadSynchronous(); }
+		if (!Options.CharacterClass && World->GetAuthGameMode())
+		{
+			UClass* DefaultPawnClass = World->GetAuthGameMode()->DefaultPawnClass;
+			if (DefaultPawnClass && DefaultPawnClass->IsChildOf<AALSBaseCharacter>()) { Options.CharacterClass = DefaultPawnClass; }
+		}
+
+		if (Options.OutputPath.IsEmpty())
+		{
+			Options.OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ALSBenchmark"),
+			                                     FString::Printf(TEXT("ALSBenchmark-%s.json"), *FDateTime::Now().ToString()));
+		}
+
+		UALSBenchmarkSubsystem* Benchmark = World->GetSubsystem<UALSBenchmarkSubsystem>();
+		if (!Benchmark || !Benchmark->StartBenchmark(Options))
+		{
+			UE_LOG(LogAlsBenchmark, Error, TEXT("ALS.Benchmark: Couldn't start, a benchmark is already running or no ALS character class is set"));
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+		TEXT("ALS.Benchmark"),
+		TEXT("Spawns scripted ALS characters and writes their per frame cost to a JSON report. ")
+		TEXT("Usage: ALS.Benchmark [Counts=1,50,200,500] [Warmup=60] [Frames=600] [Phase=Ragdoll] [Compare=AnimWorker|CurveReads|ReplicationThresholds] ")
+		TEXT("[Class=/Game/Path/Character.Character_C] ")
+		TEXT("[Output=Path.json] [Quit]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ExecuteBenchmarkCommand));
+}
+
+void UALSBenchmarkSubsystem::Deinitialize()
+{
+	if (bRunning)
+	{
+		UE_LOG(LogAlsBenchmark, Warning, TEXT("Benchmark aborted, the world was torn down before it finished"));
+		FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+		FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+		FALSBenchmarkCounters::bRecording = false;
+		if (Options.Comparison != INDEX_NONE) { ALSBenchmark::RestoreSettings(*UALS_Settings::Get(), InitialSettings); }
+		bRunning = false;
+	}
+
+	Super::Deinitialize();
+}
+
+bool UALSBenchmarkSubsystem::StartBenchmark(const FALSBenchmarkOptions& InOptions)
+{
+	if (bRunning || !InOptions.CharacterClass || InOptions.CharacterCounts.Num() == 0) { return false; }
+
+	Options = InOptions;
+	Runs.Reset();
+	RunIndex = 0;
+	RunFrame = 0;
+	ScriptTime = 0.0f;
+	bRunning = true;
+
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UALSBenchmarkSubsystem::OnWorldTickStart);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UALSBenchmarkSubsystem::OnWorldPostActorTick);
+
+	InitialSettings = ALSBenchmark::SaveSettings(*UALS_Settings::Get());
+
+	UE_LOG(LogAlsBenchmark, Log, TEXT("Benchmark started with %s"), *Options.CharacterClass->GetPathName());
+	StartRun();
+	return true;
+}
+
+int32 UALSBenchmarkSubsystem::GetRunCount() const
+{
+	return Options.CharacterCounts.Num() * (Options.Comparison != INDEX_NONE ? 2 : 1);
+}
+
+void UALSBenchmarkSubsystem::StartRun()
+{
+	if (Options.Comparison == INDEX_NONE)
+	{
+		SpawnCharacters(Options.CharacterCounts[RunIndex]);
+		return;
+	}
+
+	// Run every count with the setting disabled first, then enabled
+	const bool bComparedSetting = RunIndex % 2 == 1;
+	ALSBenchmark::ComparisonSettings[Options.Comparison](*UALS_Settings::Get(), InitialSettings, bComparedSetting);
+	SpawnCharacters(Options.CharacterCounts[RunIndex / 2]);
+	Runs.Last().bComparedSetting = bComparedSetting;
+
+	UE_LOG(LogAlsBenchmark, Log, TEXT("Benchmark running with %s %s"), ALSBenchmark::ComparisonNames[Options.Comparison],
+		   bComparedSetting ? TEXT("enabled") : TEXT("disabled"));
+}
+
+void UALSBenchmarkSubsystem::OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, const float DeltaSeconds)
+{
+	if (InWorld != GetWorld() || !bRunning) { return; }
+
+	// Spawning and destroying happens here, so that it's never part of a measured frame
+	if (RunFrame >= Options.WarmupFrames + Options.MeasuredFrames)
+	{
+		FinishConnectionSamples();
+		DestroyCharacters();
+		if (++RunIndex >= GetRunCount())
+		{
+			Finish();
+			return;
+		}
+
+		StartRun();
+		RunFrame = 0;
+		ScriptTime = 0.0f;
+	}
+
+	DriveCharacters(DeltaSeconds);
+
+	// The net driver flushes after the actor tick, so the traffic is counted from here until the next tick start
+	if (RunFrame == Options.WarmupFrames) { StartConnectionSamples(); }
+
+	FALSBenchmarkCounters::Reset();
+	FALSBenchmarkCounters::bRecording = RunFrame >= Options.WarmupFrames;
+	TickStartCycles = FPlatformTime::Cycles64();
+}
+
+void UALSBenchmarkSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, const float DeltaSeconds)
+{
+	if (InWorld != GetWorld() || !bRunning) { return; }
+
+	if (FALSBenchmarkCounters::bRecording)
+	{
+		FRunSamples& Run = Runs.Last();
+		Run.MeasuredSeconds += DeltaSeconds;
+		Run.WorldTickMs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - TickStartCycles));
+		// Game thread time of the previous frame, as in "stat unit". Unlike the world tick, it covers replication.
+		Run.GameThreadMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+		Run.CharacterTickMs.Add(FPlatformTime::ToMilliseconds64(FALSBenchmarkCounters::CharacterTickCycles));
+		Run.AnimUpdateMs.Add(FPlatformTime::ToMilliseconds64(FALSBenchmarkCounters::AnimUpdateCycles));
+		Run.CurveReadMs.Add(FPlatformTime::ToMilliseconds64(FALSBenchmarkCounters::CurveReadCycles));
+		Run.SceneQueries.Add(FALSBenchmarkCounters::SceneQueries);
+		Run.LandPredictionMaxDeviation = FMath::Max(Run.LandPredictionMaxDeviation,
+													FALSBenchmarkCounters::LandPredictionMaxDeviation);
+		Run.LandPredictionDeviations += FALSBenchmarkCounters::LandPredictionDeviations;
+		FALSBenchmarkCounters::bRecording = false;
+	}
+
+	++RunFrame;
+}
+
+void UALSBenchmarkSubsystem::SpawnCharacters(const int32 Count)
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	FVector Origin(0.0f, 0.0f, 200.0f);
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Origin = It->GetActorLocation();
+		break;
+	}
+
+	FRunSamples& Run = Runs.AddDefaulted_GetRef();
+	Run.CharacterCount = Count;
+	Run.WorldTickMs.Reserve(Options.MeasuredFrames);
+	Run.GameThreadMs.Reserve(Options.MeasuredFrames);
+	Run.CharacterTickMs.Reserve(Options.MeasuredFrames);
+	Run.AnimUpdateMs.Reserve(Options.MeasuredFrames);
+	Run.CurveReadMs.Reserve(Options.MeasuredFrames);
+	Run.SceneQueries.Reserve(Options.MeasuredFrames);
+
+	const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+	const float PhaseCycle = ALSBenchmark::PhaseDuration * static_cast<float>(ALSBenchmark::EPhase::Count);
+	FRandomStream RandomStream(Count);
+
+	ScriptedCharacters.Reset(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Offset((Index % Columns - Columns / 2) * ALSBenchmark::SpawnSpacing,
+		                     (Index / Columns - Columns / 2) * ALSBenchmark::SpawnSpacing, 0.0f);
+		const FTransform SpawnTransform(FRotator(0.0f, RandomStream.FRandRange(-180.0f, 180.0f), 0.0f), Origin + Offset);
+
+		// Possess with a plain AI controller, the default one would run its own behavior on top of the script
+		AALSBaseCharacter* Character = World->SpawnActorDeferred<AALSBaseCharacter>(
+			Options.CharacterClass, SpawnTransform, nullptr, nullptr,
+			ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (!Character) { continue; }
+
+		Character->AutoPossessAI = EAutoPossessAI::Disabled;
+		Character->AIControllerClass = AAIController::StaticClass();
+		Character->FinishSpawning(SpawnTransform);
+		Character->SpawnDefaultController();
+
+		FScriptedCharacter& Scripted = ScriptedCharacters.AddDefaulted_GetRef();
+		Scripted.Character = Character;
+		Scripted.Controller = Character->GetController();
+		Scripted.Direction = SpawnTransform.GetRotation().GetForwardVector();
+		// Spread the characters over the phases, so that every behaviour is covered in every frame
+		Scripted.PhaseOffset = PhaseCycle * Index / Count;
+	}
+
+	UE_LOG(LogAlsBenchmark, Log, TEXT("Benchmark running with %d characters"), ScriptedCharacters.Num());
+}
+
+void UALSBenchmarkSubsystem::DestroyCharacters()
+{
+	for (const FScriptedCharacter& Scripted : ScriptedCharacters)
+	{
+		if (Scripted.Controller.IsValid()) { Scripted.Controller->Destroy(); }
+		if (Scripted.Character.IsValid()) { Scripted.Character->Destroy(); }
+	}
+	ScriptedCharacters.Reset();
+}
+
+void UALSBenchmarkSubsystem::DriveCharacters(const float DeltaSeconds)
+{
+	using ALSBenchmark::EPhase;
+
+	ScriptTime += DeltaSeconds;
+	const int32 PhaseCount = static_cast<int32>(EPhase::Count);
+
+	for (FScriptedCharacter& Scripted : ScriptedCharacters)
+	{
+		AALSBaseCharacter* Character = Scripted.Character.Get();
+		if (!Character) { continue; }
+
+		const int32 NewPhase = Options.Phase != INDEX_NONE
+								   ? Options.Phase
+								   : FMath::FloorToInt((ScriptTime + Scripted.PhaseOffset) / ALSBenchmark::PhaseDuration) % PhaseCount;
+		if (NewPhase != Scripted.Phase)
+		{
+			// Step 1: Leave the previous phase
+			switch (static_cast<EPhase>(Scripted.Phase))
+			{
+			case EPhase::Falling: Character->StopJumping();
+				break;
+			case EPhase::Flight: Character->SetFlightMode(EALSFlightMode::None);
+				break;
+			case EPhase::Ragdoll: if (Character->GetMovementState() == EALSMovementState::Ragdoll) { Character->ReplicatedRagdollEnd(); }
+				break;
+			default: break;
+			}
+
+			// Step 2: Enter the new one
+			Scripted.Phase = NewPhase;
+			switch (static_cast<EPhase>(NewPhase))
+			{
+			case EPhase::Walking: Character->SetDesiredGait(EALSGait::GaitSlow);
+				break;
+			case EPhase::Sprinting: Character->SetDesiredGait(EALSGait::GaitFast);
+				break;
+			case EPhase::Falling: Character->SetDesiredGait(EALSGait::GaitNormal);
+				Character->Jump();
+				break;
+			case EPhase::Flight: Character->SetFlightMode(EALSFlightMode::Neutral);
+				break;
+			case EPhase::Mantling: Character->SetDesiredGait(EALSGait::GaitNormal);
+				break;
+			case EPhase::Ragdoll: Character->ReplicatedRagdollStart();
+				break;
+			default: break;
+			}
+		}
+
+		if (static_cast<EPhase>(Scripted.Phase) == EPhase::Ragdoll) { continue; }
+
+		// Walk in wide circles, so that the crowd stays around its spawn point
+		Scripted.Direction = Scripted.Direction.RotateAngleAxis(ALSBenchmark::TurnRate * DeltaSeconds, FVector::UpVector);
+		Character->AddMovementInput(Scripted.Direction, 1.0f);
+
+		if (static_cast<EPhase>(Scripted.Phase) == EPhase::Mantling
+			&& Character->GetMovementState() == EALSMovementState::Grounded
+			&& Character->GetMovementAction() == EALSMovementAction::None)
+		{
+			Character->MantleCheckGrounded();
+		}
+	}
+}
+
+void UALSBenchmarkSubsystem::StartConnectionSamples()
+{
+	const UWorld* World = GetWorld();
+	check(World);
+
+	const UNetDriver* NetDriver = World->GetNetDriver();
+	if (!NetDriver) { return; }
+
+	FRunSamples& Run = Runs.Last();
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection) { continue; }
+
+		FConnectionSamples& Samples = Run.Connections.AddDefaulted_GetRef();
+		Samples.Connection = Connection;
+		Samples.Address = Connection->LowLevelGetRemoteAddress(true);
+		Samples.StartInBytes = Connection->InTotalBytes;
+		Samples.StartOutBytes = Connection->OutTotalBytes;
+	}
+}
+
+void UALSBenchmarkSubsystem::FinishConnectionSamples()
+{
+	for (FConnectionSamples& Samples : Runs.Last().Connections)
+	{
+		// Connections that closed during the run keep zero traffic
+		const UNetConnection* Connection = Samples.Connection.Get();
+		if (!Connection) { continue; }
+
+		// The totals are 32 bit, subtract unsigned so that a wrap during the run doesn't matter
+		Samples.InBytes = static_cast<uint32>(Connection->InTotalBytes) - static_cast<uint32>(Samples.StartInBytes);
+		Samples.OutBytes = static_cast<uint32>(Connection->OutTotalBytes) - static_cast<uint32>(Samples.StartOutBytes);
+	}
+}
+
+void UALSBenchmarkSubsystem::Finish()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	FALSBenchmarkCounters::bRecording = false;
+	if (Options.Comparison != INDEX_NONE) { ALSBenchmark::RestoreSettings(*UALS_Settings::Get(), InitialSettings); }
+	bRunning = false;
+
+	WriteReport();
+
+	if (Options.bQuitWhenDone) { FPlatformMisc::RequestExit(false); }
+}
+
+void UALSBenchmarkSubsystem::WriteReport() const
+{
+	const UWorld* World = GetWorld();
+	check(World);
+	const UALS_Settings* Settings = UALS_Settings::Get();
+
+	FString Report;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Report);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("Map"), World->GetMapName());
+	Writer->WriteValue(TEXT("CharacterClass"), Options.CharacterClass->GetPathName());
+	Writer->WriteValue(TEXT("WarmupFrames"), Options.WarmupFrames);
+	Writer->WriteValue(TEXT("MeasuredFrames"), Options.MeasuredFrames);
+	Writer->WriteValue(TEXT("AnimLOD"), Settings->bEnableAnimLOD);
+	Writer->WriteValue(TEXT("BakedCurves"), Settings->bUseBakedCurves);
+	Writer->WriteValue(TEXT("BatchedLocomotion"), Settings->bUseBatchedLocomotion);
+	Writer->WriteValue(TEXT("Phase"), Options.Phase != INDEX_NONE ? ALSBenchmark::PhaseNames[Options.Phase] : TEXT("All"));
+	Writer->WriteValue(TEXT("ReplicationBuckets"), Settings->bUseReplicationBuckets);
+	Writer->WriteValue(TEXT("RagdollSnapshots"), Settings->bUseRagdollSnapshots);
+	Writer->WriteValue(TEXT("ReplicatedAccelerationThreshold"), Settings->ReplicatedAccelerationThreshold);
+	Writer->WriteValue(TEXT("ReplicatedControlRotationThreshold"), Settings->ReplicatedControlRotationThreshold);
+	Writer->WriteValue(TEXT("VerifyAsyncLandPrediction"), Settings->bVerifyAsyncLandPrediction);
+	Writer->WriteValue(TEXT("DedicatedServer"), World->IsNetMode(NM_DedicatedServer));
+	Writer->WriteValue(TEXT("Comparison"), Options.Comparison != INDEX_NONE
+											   ? ALSBenchmark::ComparisonNames[Options.Comparison]
+											   : TEXT("None"));
+
+	Writer->WriteArrayStart(TEXT("Runs"));
+	for (const FRunSamples& Run : Runs)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Characters"), Run.CharacterCount);
+		if (Options.Comparison != INDEX_NONE) { Writer->WriteValue(TEXT("ComparedSetting"), Run.bComparedSetting); }
+		ALSBenchmark::WriteSampleStats(*Writer, TEXT("WorldTickMs"), Run.WorldTickMs);
+		ALSBenchmark::WriteSampleStats(*Writer, TEXT("GameThreadMs"), Run.GameThreadMs);
+		ALSBenchmark::WriteSampleStats(*Writer, TEXT("CharacterTickMs"), Run.CharacterTickMs);
+		ALSBenchmark::WriteSampleStats(*Writer, TEXT("AnimUpdateMs"), Run.AnimUpdateMs);
+		// Game thread cost of the anim update of one character, this is what the anim worker update saves
+		Writer->WriteValue(TEXT("AnimUpdateUsPerCharacter"),
+						   ALSBenchmark::GetAverage(Run.AnimUpdateMs) * 1000.0f / FMath::Max(Run.CharacterCount, 1));
+		ALSBenchmark::WriteSampleStats(*Writer, TEXT("CurveReadMs"), Run.CurveReadMs);
+		Writer->WriteValue(TEXT("CurveReadUsPerCharacter"),
+						   ALSBenchmark::GetAverage(Run.CurveReadMs) * 1000.0f / FMath::Max(Run.CharacterCount, 1));
+		ALSBenchmark::WriteSampleStats(*Writer, TEXT("SceneQueries"), Run.SceneQueries);
+		if (Settings->bVerifyAsyncLandPrediction)
+		{
+			Writer->WriteValue(TEXT("LandPredictionMaxDeviation"), Run.LandPredictionMaxDeviation);
+			Writer->WriteValue(TEXT("LandPredictionDeviations"), Run.LandPredictionDeviations);
+		}
+
+		Writer->WriteArrayStart(TEXT("Connections"));
+		for (const FConnectionSamples& Samples : Run.Connections)
+		{
+			const float Seconds = FMath::Max(Run.MeasuredSeconds, KINDA_SMALL_NUMBER);
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("Address"), Samples.Address);
+			Writer->WriteValue(TEXT("InBytesPerSecond"), Samples.InBytes / Seconds);
+			Writer->WriteValue(TEXT("OutBytesPerSecond"), Samples.OutBytes / Seconds);
+			Writer->WriteValue(TEXT("OutBytesPerCharacterSecond"), Samples.OutBytes / Seconds / FMath::Max(Run.CharacterCount, 1));
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (FFileHelper::SaveStringToFile(Report, *Options.OutputPath))
+	{
+		UE_LOG(LogAlsBenchmark, Log, TEXT("Benchmark report written to %s"), *Options.OutputPath);
+	}
+	else
+	{
+		UE_LOG(LogAlsBenchmark, Error, TEXT("Couldn't write the benchmark report to %s"), *Options.OutputPath);
+	}
+}
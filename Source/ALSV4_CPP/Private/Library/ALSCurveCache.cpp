@@ -0,0 +1,125 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSCurveCache.h"
+#include "ALS_Settings.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+
+DEFINE_LOG_CATEGORY(LogAlsCurveCache)
+
+const FALSBakedCurve* UALSCurveCacheSubsystem::FindOrBake(const UCurveBase* Curve)
+{
+	check(IsInGameThread());
+	if (!Curve || !UALS_Settings::Get()->bUseBakedCurves) { return nullptr; }
+
+	// A null entry means the curve was already rejected, and is evaluated exactly.
+	const TObjectKey<UCurveBase> Key(Curve);
+	if (const TUniquePtr<FALSBakedCurve>* Found = BakedCurves.Find(Key)) { return Found->Get(); }
+	return BakedCurves.Add(Key, Bake(Curve)).Get();
+}
+
+float UALSCurveCacheSubsystem::GetFloatValue(const UCurveFloat* Curve, const float Time)
+{
+	return GetFloatValue(Curve, FindOrBake(Curve), Time);
+}
+
+FVector UALSCurveCacheSubsystem::GetVectorValue(const UCurveVector* Curve, const float Time)
+{
+	return GetVectorValue(Curve, FindOrBake(Curve), Time);
+}
+
+float UALSCurveCacheSubsystem::GetFloatValue(const UCurveFloat* Curve, const FALSBakedCurve* BakedCurve,
+											 const float Time)
+{
+	return BakedCurve ? BakedCurve->Evaluate(Time).X : Curve->GetFloatValue(Time);
+}
+
+FVector UALSCurveCacheSubsystem::GetVectorValue(const UCurveVector* Curve, const FALSBakedCurve* BakedCurve,
+												const float Time)
+{
+	return BakedCurve ? BakedCurve->Evaluate(Time) : Curve->GetVectorValue(Time);
+}
+
+void UALSCurveCacheSubsystem::Deinitialize()
+{
+	BakedCurves.Empty();
+	Super::Deinitialize();
+}
+
+TUniquePtr<FALSBakedCurve> UALSCurveCacheSubsystem::Bake(const UCurveBase* Curve)
+{
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	const TArray<FRichCurveEditInfoConst> Channels = Curve->GetCurves();
+	if (Channels.Num() == 0 || Channels.Num() > 3) { return nullptr; }
+
+	// Step 1: Find the time range of all channels. Only constant extrapolation can be represented by a clamped table.
+	float MinTime = TNumericLimits<float>::Max();
+	float MaxTime = TNumericLimits<float>::Lowest();
+	for (const FRichCurveEditInfoConst& Channel : Channels)
+	{
+		const FRealCurve* RealCurve = Channel.CurveToEdit;
+		if (!RealCurve || RealCurve->PreInfinityExtrap != RCCE_Constant || RealCurve->PostInfinityExtrap != RCCE_Constant)
+		{
+			UE_LOG(LogAlsCurveCache, Log, TEXT("%s uses non constant extrapolation, it will be evaluated exactly"),
+				   *Curve->GetName());
+			return nullptr;
+		}
+
+		if (RealCurve->GetNumKeys() > 0)
+		{
+			float ChannelMin, ChannelMax;
+			RealCurve->GetTimeRange(ChannelMin, ChannelMax);
+			MinTime = FMath::Min(MinTime, ChannelMin);
+			MaxTime = FMath::Max(MaxTime, ChannelMax);
+		}
+	}
+
+	if (MinTime > MaxTime)
+	{
+		MinTime = 0.0f;
+		MaxTime = 0.0f;
+	}
+
+	// Step 2: Resample all channels into the table.
+	const int32 NumSamples = FMath::Max(Settings->BakedCurveResolution, 2);
+	const float Step = FMath::Max((MaxTime - MinTime) / static_cast<float>(NumSamples - 1), KINDA_SMALL_NUMBER);
+	const auto EvaluateSource = [&Channels](const float Time)
+	{
+		FVector Value = FVector::ZeroVector;
+		for (int32 Index = 0; Index < Channels.Num(); ++Index) { Value[Index] = Channels[Index].CurveToEdit->Eval(Time); }
+		return Value;
+	};
+
+	TUniquePtr<FALSBakedCurve> BakedCurve = MakeUnique<FALSBakedCurve>();
+	BakedCurve->MinTime = MinTime;
+	BakedCurve->InvStep = 1.0f / Step;
+	BakedCurve->Samples.SetNumUninitialized(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		BakedCurve->Samples[Index] = EvaluateSource(MinTime + Step * static_cast<float>(Index));
+	}
+
+	// Step 3: Check the error bound between the samples, where the linear interpolation is the least accurate.
+	for (int32 Index = 0; Index < NumSamples - 1; ++Index)
+	{
+		const float Time = MinTime + Step * (static_cast<float>(Index) + 0.5f);
+		const FVector Error = (BakedCurve->Evaluate(Time) - EvaluateSource(Time)).GetAbs();
+		BakedCurve->MaxError = FMath::Max(BakedCurve->MaxError, Error.GetMax());
+	}
+
+	if (BakedCurve->MaxError > Settings->BakedCurveMaxError)
+	{
+		UE_LOG(LogAlsCurveCache, Warning,
+			   TEXT("%s can't be baked within the error bound (%f > %f), it will be evaluated exactly"),
+			   *Curve->GetName(), BakedCurve->MaxError, Settings->BakedCurveMaxError);
+		return nullptr;
+	}
+
+	return BakedCurve;
+}
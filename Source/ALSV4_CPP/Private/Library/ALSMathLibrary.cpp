@@ -8,8 +8,10 @@
 
 #include "Library/ALSMathLibrary.h"
 #include "ALS_Settings.h"
+#include "Library/ALSStats.h"
 #include "Components/CapsuleComponent.h"
 #include "Library/ALSCharacterStructLibrary.h"
+#include "Library/ALSLocomotionCoreConversion.h"
 
 FTransform UALSMathLibrary::MantleComponentLocalToWorld(const FALSComponentAndTransform& CompAndTransform)
 {
@@ -22,11 +24,8 @@ FTransform UALSMathLibrary::MantleComponentLocalToWorld(const FALSComponentAndTr
 
 TPair<float, float> UALSMathLibrary::FixDiagonalGamepadValues(const float X, const float Y)
 {
-	float ResultY = X * FMath::GetMappedRangeValueClamped(FVector2D(0.0f, 0.6f), FVector2D(1.0f, 1.2f), FMath::Abs(Y));
-	ResultY = FMath::Clamp(ResultY, -1.0f, 1.0f);
-	float ResultX = Y * FMath::GetMappedRangeValueClamped(FVector2D(0.0f, 0.6f), FVector2D(1.0f, 1.2f), FMath::Abs(X));
-	ResultX = FMath::Clamp(ResultX, -1.0f, 1.0f);
-	return TPair<float, float>(ResultY, ResultX);
+	return TPair<float, float>(FALSLocomotionCore::FixDiagonalGamepadAxis(X, Y),
+							   FALSLocomotionCore::FixDiagonalGamepadAxis(Y, X));
 }
 
 FVector UALSMathLibrary::GetCapsuleBaseLocation(const float ZOffset, UCapsuleComponent* Capsule)
@@ -59,6 +58,7 @@ bool UALSMathLibrary::CapsuleHasRoomCheck(UCapsuleComponent* Capsule, const FVec
 	Params.AddIgnoredActor(Capsule->GetOwner());
 
 	FHitResult HitResult;
+	FALSStats::CountSceneQuery();
 	World->SweepSingleByProfile(HitResult,
 								TraceStart,
 								TraceEnd,
@@ -73,30 +73,13 @@ bool UALSMathLibrary::CapsuleHasRoomCheck(UCapsuleComponent* Capsule, const FVec
 bool UALSMathLibrary::AngleInRange(const float Angle, const float MinAngle, const float MaxAngle, const float Buffer,
 								   const bool IncreaseBuffer)
 {
-	if (IncreaseBuffer) { return Angle >= MinAngle - Buffer && Angle <= MaxAngle + Buffer; }
-	return Angle >= MinAngle + Buffer && Angle <= MaxAngle - Buffer;
+	return FALSLocomotionCore::AngleInRange(Angle, MinAngle, MaxAngle, Buffer, IncreaseBuffer);
 }
 
 EALSMovementDirection UALSMathLibrary::CalculateQuadrant(const EALSMovementDirection Current, const float FRThreshold,
 														 const float FLThreshold, const float BRThreshold,
 														 const float BLThreshold, const float Buffer, const float Angle)
 {
-	// Take the input angle and determine its quadrant (direction). Use the current Movement Direction to increase or
-	// decrease the buffers on the angle ranges for each quadrant.
-	if (AngleInRange(Angle, FLThreshold, FRThreshold, Buffer,
-	                 Current != EALSMovementDirection::Forward || Current != EALSMovementDirection::Backward))
-	{
-		return EALSMovementDirection::Forward;
-	}
-	if (AngleInRange(Angle, FRThreshold, BRThreshold, Buffer,
-	                 Current != EALSMovementDirection::Right || Current != EALSMovementDirection::Left))
-	{
-		return EALSMovementDirection::Right;
-	}
-	if (AngleInRange(Angle, BLThreshold, FLThreshold, Buffer,
-	                 Current != EALSMovementDirection::Right || Current != EALSMovementDirection::Left))
-	{
-		return EALSMovementDirection::Left;
-	}
-	return EALSMovementDirection::Backward;
+	return ALSLocomotionCore::FromCore(FALSLocomotionCore::CalculateQuadrant(
+		ALSLocomotionCore::ToCore(Current), FRThreshold, FLThreshold, BRThreshold, BLThreshold, Buffer, Angle));
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSMovementModel.h"
+#include "Library/ALSCurveCache.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+
+const FALSMovementSettings& FALSMovementModel::SelectMovementSettings(const FALSMovementStateSettings& Data,
+																	const EALSRotationMode RotationMode,
+																	const EALSMovementState MovementState,
+																	const EALSStance Stance)
+{
+	if (RotationMode == EALSRotationMode::VelocityDirection)
+	{
+		if (MovementState == EALSMovementState::Grounded)
+		{
+			if (Stance == EALSStance::Standing) { return Data.VelocityDirection.Standing; }
+			if (Stance == EALSStance::Crouching) { return Data.VelocityDirection.Crouching; }
+		}
+		if (MovementState == EALSMovementState::Flight) { return Data.VelocityDirection.Flying; }
+		if (MovementState == EALSMovementState::Swimming) { return Data.VelocityDirection.Swimming; }
+	}
+	else if (RotationMode == EALSRotationMode::LookingDirection)
+	{
+		if (MovementState == EALSMovementState::Grounded)
+		{
+			if (Stance == EALSStance::Standing) { return Data.LookingDirection.Standing; }
+			if (Stance == EALSStance::Crouching) { return Data.LookingDirection.Crouching; }
+		}
+		if (MovementState == EALSMovementState::Flight) { return Data.LookingDirection.Flying; }
+		if (MovementState == EALSMovementState::Swimming) { return Data.LookingDirection.Swimming; }
+	}
+	else if (RotationMode == EALSRotationMode::Aiming)
+	{
+		if (MovementState == EALSMovementState::Grounded)
+		{
+			if (Stance == EALSStance::Standing) { return Data.Aiming.Standing; }
+			if (Stance == EALSStance::Crouching) { return Data.Aiming.Crouching; }
+		}
+		if (MovementState == EALSMovementState::Flight) { return Data.Aiming.Flying; }
+		if (MovementState == EALSMovementState::Swimming) { return Data.Aiming.Swimming; }
+	}
+
+	// Default to velocity dir standing
+	return Data.VelocityDirection.Standing;
+}
+
+TSharedPtr<const FALSMovementModel> UALSMovementModelSubsystem::FindOrBuild(const FDataTableRowHandle& Handle)
+{
+	check(IsInGameThread());
+	if (!Handle.DataTable) { return nullptr; }
+
+	const TPair<TObjectKey<UDataTable>, FName> Key(Handle.DataTable, Handle.RowName);
+	if (const TSharedPtr<const FALSMovementModel>* Found = Models.Find(Key)) { return *Found; }
+
+	TSharedPtr<const FALSMovementModel> Model = Build(Handle);
+	if (Model) { Models.Add(Key, Model); }
+	return Model;
+}
+
+void UALSMovementModelSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	for (const TWeakObjectPtr<UDataTable>& DataTable : WatchedDataTables)
+	{
+		if (DataTable.IsValid()) { DataTable->OnDataTableChanged().RemoveAll(this); }
+	}
+	WatchedDataTables.Empty();
+#endif
+
+	Models.Empty();
+	OnMovementModelsChanged.Clear();
+	Super::Deinitialize();
+}
+
+TSharedPtr<const FALSMovementModel> UALSMovementModelSubsystem::Build(const FDataTableRowHandle& Handle)
+{
+	static const FString ContextString(TEXT("UALSMovementModelSubsystem"));
+	const FALSMovementStateSettings* Row = Handle.GetRow<FALSMovementStateSettings>(ContextString);
+	if (!Row) { return nullptr; }
+
+	UWorld* World = GetWorld();
+	check(World);
+	UALSCurveCacheSubsystem* CurveCache = World->GetSubsystem<UALSCurveCacheSubsystem>();
+
+	// Step 1: Resolve the settings of every state combination, and bake their curves.
+	TSharedPtr<FALSMovementModel> Model = MakeShared<FALSMovementModel>();
+	Model->Data = *Row;
+	Model->Entries.SetNum(FALSMovementModel::EntryCount);
+	for (int32 RotationModeIndex = 0; RotationModeIndex < FALSMovementModel::RotationModeCount; ++RotationModeIndex)
+	{
+		for (int32 StateIndex = 0; StateIndex < FALSMovementModel::MovementStateCount; ++StateIndex)
+		{
+			for (int32 StanceIndex = 0; StanceIndex < FALSMovementModel::StanceCount; ++StanceIndex)
+			{
+				const EALSRotationMode RotationMode = static_cast<EALSRotationMode>(RotationModeIndex);
+				const EALSMovementState MovementState = static_cast<EALSMovementState>(StateIndex);
+				const EALSStance Stance = static_cast<EALSStance>(StanceIndex);
+
+				FALSMovementModelEntry& Entry =
+					Model->Entries[FALSMovementModel::GetEntryIndex(RotationMode, MovementState, Stance)];
+				Entry.Settings = FALSMovementModel::SelectMovementSettings(Model->Data, RotationMode, MovementState,
+																		   Stance);
+				if (CurveCache)
+				{
+					Entry.BakedMovementCurve = CurveCache->FindOrBake(Entry.Settings.MovementCurve);
+					Entry.BakedRotationRateCurve = CurveCache->FindOrBake(Entry.Settings.RotationRateCurve);
+				}
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	// Step 2: Rebuild the models of the table when it's edited or reimported.
+	// Row handles only reference the table as const, but its change delegate isn't.
+	UDataTable* DataTable = const_cast<UDataTable*>(Handle.DataTable);
+	if (!WatchedDataTables.Contains(DataTable))
+	{
+		DataTable->OnDataTableChanged().AddUObject(this, &UALSMovementModelSubsystem::OnDataTableChanged,
+												   Handle.DataTable);
+		WatchedDataTables.Add(DataTable);
+	}
+#endif
+
+	return Model;
+}
+
+#if WITH_EDITOR
+void UALSMovementModelSubsystem::OnDataTableChanged(const UDataTable* DataTable)
+{
+	for (auto It = Models.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key == TObjectKey<UDataTable>(DataTable)) { It.RemoveCurrent(); }
+	}
+	OnMovementModelsChanged.Broadcast();
+}
+#endif
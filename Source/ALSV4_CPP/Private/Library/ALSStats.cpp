@@ -0,0 +1,49 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSStats.h"
+
+DEFINE_STAT(STAT_ALS_CharacterTick);
+DEFINE_STAT(STAT_ALS_BatchedCharacterTick);
+DEFINE_STAT(STAT_ALS_ParallelLocomotion);
+DEFINE_STAT(STAT_ALS_SetEssentialValues);
+DEFINE_STAT(STAT_ALS_UpdateCharacterMovement);
+DEFINE_STAT(STAT_ALS_UpdateFlightMovement);
+DEFINE_STAT(STAT_ALS_MantleCheck);
+DEFINE_STAT(STAT_ALS_RagdollUpdate);
+DEFINE_STAT(STAT_ALS_AnimUpdate);
+DEFINE_STAT(STAT_ALS_AnimWorkerUpdate);
+DEFINE_STAT(STAT_ALS_UpdateFootIK);
+DEFINE_STAT(STAT_ALS_CalculateLandPrediction);
+DEFINE_STAT(STAT_ALS_LocomotionBatch);
+DEFINE_STAT(STAT_ALS_CustomCameraBehavior);
+DEFINE_STAT(STAT_ALS_SceneQueries);
+DEFINE_STAT(STAT_ALS_SkippedMovementSettingsWrites);
+DEFINE_STAT(STAT_ALS_CulledCosmeticEvents);
+DEFINE_STAT(STAT_ALS_LandPredictionDeviations);
+DEFINE_STAT(STAT_ALS_IdleCharacters);
+
+CSV_DEFINE_CATEGORY_MODULE(ALSV4_CPP_API, ALS, true);
+
+bool FALSBenchmarkCounters::bRecording = false;
+uint64 FALSBenchmarkCounters::CharacterTickCycles = 0;
+uint64 FALSBenchmarkCounters::AnimUpdateCycles = 0;
+uint64 FALSBenchmarkCounters::CurveReadCycles = 0;
+int32 FALSBenchmarkCounters::SceneQueries = 0;
+float FALSBenchmarkCounters::LandPredictionMaxDeviation = 0.0f;
+int32 FALSBenchmarkCounters::LandPredictionDeviations = 0;
+
+void FALSBenchmarkCounters::Reset()
+{
+	CharacterTickCycles = 0;
+	AnimUpdateCycles = 0;
+	CurveReadCycles = 0;
+	SceneQueries = 0;
+	LandPredictionMaxDeviation = 0.0f;
+	LandPredictionDeviations = 0;
+}
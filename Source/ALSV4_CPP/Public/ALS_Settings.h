@@ -3,8 +3,11 @@
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
 #include "UObject/NoExportTypes.h"
+#include "Library/ALSAnimationStructLibrary.h"
 #include "ALS_Settings.generated.h"
 
+class AALSBaseCharacter;
+
 /**
 * Configurable settings for the ALSV4_CPP_Faerie plugin.
 */
@@ -14,6 +17,8 @@ class ALSV4_CPP_API UALS_Settings final : public UDeveloperSettings
 	GENERATED_BODY()
 
 public:
+	UALS_Settings();
+
 	// The collision profile preset for the character.
 	UPROPERTY(EditAnywhere, Config, Category = "General")
 	FName ALS_Profile;
@@ -49,6 +54,13 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Mantling")
 	TEnumAsByte<ECollisionChannel> MantleCheckChannel;
 
+	/**
+	* How far the ledge of a mantle predicted by a client may be from what the server accepts, in cm. Covers the
+	* difference between the client and server locations of the character when the mantle starts.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Mantling", meta = (ClampMin = 0))
+	float MantleValidationTolerance = 50.0f;
+
 	/**
 	* This channel is used by the flight system to determine the altitude from the ground. WorldStatic works, but if
 	* you have a landscape or other large mass that you want to count as ground, then you can change this.
@@ -68,6 +80,161 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Flight")
 	float TroposphereHeight = 1000000.f;
 
+	// Run the pure math of the anim update in the anim instance proxy, on a worker thread when multi threaded animation
+	// update is enabled. Disable to run all of it in NativeUpdateAnimation, on the game thread.
+	UPROPERTY(EditAnywhere, Config, Category = "Anim Worker Update")
+	bool bUseAnimWorkerUpdate = true;
+
+	// Read the ALS anim curves in one pass over the anim instance's curve list. Disable to look each of them up by name.
+	UPROPERTY(EditAnywhere, Config, Category = "Anim Curves")
+	bool bReadAnimCurvesInOnePass = true;
+
+	// Enables the significance based animation LOD tiers. When disabled, every character runs the full animation update.
+	UPROPERTY(EditAnywhere, Config, Category = "Animation LOD")
+	bool bEnableAnimLOD = false;
+
+	/**
+	 * Animation LOD tiers, from the most to the least significant. A character uses the first tier it is both closer
+	 * than MaxDistance and bigger on screen than MinScreenSize for, or the last tier if none of them match.
+	 * Characters without any local view (e.g. on a dedicated server) always use the first tier.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Animation LOD")
+	TArray<FALSAnimLODTier> AnimLODTiers;
+
+	// Characters that weren't rendered recently use the last tier, regardless of their distance.
+	UPROPERTY(EditAnywhere, Config, Category = "Animation LOD")
+	bool bUseLastAnimLODTierWhenNotRendered = true;
+
+	// Also run the synchronous sweep for async land predictions, and count the weights that are off by more than the
+	// tolerance in "stat ALS" and the benchmark. Costs an extra sweep per falling character, ignored in shipping builds.
+	UPROPERTY(EditAnywhere, Config, Category = "Land Prediction")
+	bool bVerifyAsyncLandPrediction = false;
+
+	// Largest acceptable difference between the async and synchronous land prediction weights.
+	UPROPERTY(EditAnywhere, Config, Category = "Land Prediction", meta = (ClampMin = 0, EditCondition = "bVerifyAsyncLandPrediction"))
+	float AsyncLandPredictionTolerance = 0.05f;
+
+	// Evaluate the locomotion curves through baked lookup tables. Disable to always evaluate the curve assets exactly.
+	UPROPERTY(EditAnywhere, Config, Category = "Baked Curves")
+	bool bUseBakedCurves = true;
+
+	// Number of samples each baked curve is resampled into.
+	UPROPERTY(EditAnywhere, Config, Category = "Baked Curves", meta = (ClampMin = 2, EditCondition = "bUseBakedCurves"))
+	int32 BakedCurveResolution = 256;
+
+	// Curves that differ from their baked table by more than this value anywhere are evaluated exactly instead.
+	UPROPERTY(EditAnywhere, Config, Category = "Baked Curves", meta = (ClampMin = 0, EditCondition = "bUseBakedCurves"))
+	float BakedCurveMaxError = 0.01f;
+
+	// Run the grounded movement math of all characters in one vectorized batch per frame, instead of per character.
+	// Worth it for crowds, for a handful of characters the gather/scatter costs more than it saves.
+	UPROPERTY(EditAnywhere, Config, Category = "Batched Locomotion")
+	bool bUseBatchedLocomotion = false;
+
+	// Tick all characters from one batched tick function, grouped by movement state, instead of one actor tick each.
+	// Registered characters tick every frame, regardless of their actor tick interval.
+	UPROPERTY(EditAnywhere, Config, Category = "Batched Character Tick")
+	bool bUseBatchedCharacterTick = false;
+
+	// Evaluate the essential values, gaits and grounded rotation of all batched characters in parallel, before they
+	// tick. Blueprint Tick events then see this frame's essential values. Requires bUseBatchedCharacterTick.
+	UPROPERTY(EditAnywhere, Config, Category = "Batched Character Tick", meta = (EditCondition = "bUseBatchedCharacterTick"))
+	bool bUseParallelLocomotion = false;
+
+	// Lower the actor and mesh tick rate of characters standing still on the ground with nothing to animate.
+	// They wake up as soon as they get input, velocity, a montage or a replicated state change.
+	UPROPERTY(EditAnywhere, Config, Category = "Idle Tick Rate")
+	bool bUseIdleTickRate = false;
+
+	// Actor and mesh tick interval of idle characters, in seconds.
+	UPROPERTY(EditAnywhere, Config, Category = "Idle Tick Rate", meta = (ClampMin = 0, EditCondition = "bUseIdleTickRate"))
+	float IdleTickInterval = 0.25f;
+
+	// How long a character has to stand still before its tick rate is lowered, in seconds. Lets transitions finish.
+	UPROPERTY(EditAnywhere, Config, Category = "Idle Tick Rate", meta = (ClampMin = 0, EditCondition = "bUseIdleTickRate"))
+	float IdleDelay = 1.0f;
+
+	// Only write movement component parameters when the mapped speed bucket, gait, movement mode or adjusted max speed
+	// changed, instead of every frame. Skipped writes are counted in "stat ALS".
+	UPROPERTY(EditAnywhere, Config, Category = "Change Driven Movement Settings")
+	bool bUseChangeDrivenMovementSettings = false;
+
+	// Size of the mapped speed buckets the movement curve is evaluated at. The mapped speed goes from 0 to 3.
+	UPROPERTY(EditAnywhere, Config, Category = "Change Driven Movement Settings", meta = (ClampMin = 0.001, EditCondition = "bUseChangeDrivenMovementSettings"))
+	float MappedSpeedBucketSize = 0.05f;
+
+	// Run the locomotion logic of characters at a fixed rate instead of once per frame, so hitches don't make the
+	// acceleration and aim yaw rate spike. Rendered instances interpolate rotation between steps.
+	// Replaces the parallel phase of the batched tick.
+	UPROPERTY(EditAnywhere, Config, Category = "Fixed Step Locomotion")
+	bool bUseFixedStepLocomotion = false;
+
+	// Locomotion steps per second.
+	UPROPERTY(EditAnywhere, Config, Category = "Fixed Step Locomotion", meta = (ClampMin = 1, EditCondition = "bUseFixedStepLocomotion"))
+	float FixedLocomotionStepRate = 30.0f;
+
+	// Most steps run in one frame. Steps over the limit are dropped, so a long hitch can't stall the following frames.
+	UPROPERTY(EditAnywhere, Config, Category = "Fixed Step Locomotion", meta = (ClampMin = 1, EditCondition = "bUseFixedStepLocomotion"))
+	int32 MaxLocomotionStepsPerFrame = 4;
+
+	// Acceleration changes smaller than this, per axis, don't update the replicated acceleration of a character.
+	UPROPERTY(EditAnywhere, Config, Category = "Replication", meta = (ClampMin = 0))
+	float ReplicatedAccelerationThreshold = 1.0f;
+
+	// Control rotation changes smaller than this, in degrees per axis, don't update the replicated control rotation.
+	UPROPERTY(EditAnywhere, Config, Category = "Replication", meta = (ClampMin = 0))
+	float ReplicatedControlRotationThreshold = 0.1f;
+
+	// Bucket characters by their distance to each connection's viewer. Farther buckets get a lower net priority,
+	// characters no connection views from close by replicate less often, and jump and landing events aren't sent to
+	// connections in the far bucket.
+	UPROPERTY(EditAnywhere, Config, Category = "Replication Buckets")
+	bool bUseReplicationBuckets = false;
+
+	// Characters closer than this to a viewer are in its near bucket, in cm.
+	UPROPERTY(EditAnywhere, Config, Category = "Replication Buckets", meta = (ClampMin = 0, EditCondition = "bUseReplicationBuckets"))
+	float NearReplicationDistance = 2000.0f;
+
+	// Characters farther than this from a viewer are in its far bucket, in cm.
+	UPROPERTY(EditAnywhere, Config, Category = "Replication Buckets", meta = (ClampMin = 0, EditCondition = "bUseReplicationBuckets"))
+	float FarReplicationDistance = 6000.0f;
+
+	// Net priority multipliers of the mid and far buckets.
+	UPROPERTY(EditAnywhere, Config, Category = "Replication Buckets", meta = (ClampMin = 0, EditCondition = "bUseReplicationBuckets"))
+	float MidNetPriorityScale = 0.5f;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Replication Buckets", meta = (ClampMin = 0, EditCondition = "bUseReplicationBuckets"))
+	float FarNetPriorityScale = 0.2f;
+
+	// Net update frequency of characters whose nearest viewer is in the mid or far bucket. Never above the one the
+	// character is configured with, which is used for the near bucket.
+	UPROPERTY(EditAnywhere, Config, Category = "Replication Buckets", meta = (ClampMin = 1, EditCondition = "bUseReplicationBuckets"))
+	float MidNetUpdateFrequency = 30.0f;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Replication Buckets", meta = (ClampMin = 1, EditCondition = "bUseReplicationBuckets"))
+	float FarNetUpdateFrequency = 10.0f;
+
+	// Sync ragdolls with quantized pelvis snapshots sent at a fixed rate, instead of a full location every frame.
+	// Receivers interpolate between snapshots, and pull the ragdoll harder the fresher the newest one is.
+	UPROPERTY(EditAnywhere, Config, Category = "Ragdoll Snapshots")
+	bool bUseRagdollSnapshots = false;
+
+	// Snapshots sent per second. Receivers also render this much behind, one snapshot interval.
+	UPROPERTY(EditAnywhere, Config, Category = "Ragdoll Snapshots", meta = (ClampMin = 1, EditCondition = "bUseRagdollSnapshots"))
+	float RagdollSnapshotRate = 10.0f;
+
+	// How long receivers keep moving the target along the newest snapshot velocity once they run out of snapshots.
+	UPROPERTY(EditAnywhere, Config, Category = "Ragdoll Snapshots", meta = (ClampMin = 0, EditCondition = "bUseRagdollSnapshots"))
+	float RagdollMaxExtrapolationTime = 0.25f;
+
+	// Age past the interpolation delay at which the newest snapshot stops pulling the ragdoll, in seconds.
+	UPROPERTY(EditAnywhere, Config, Category = "Ragdoll Snapshots", meta = (ClampMin = 0.01, EditCondition = "bUseRagdollSnapshots"))
+	float RagdollSnapshotMaxAge = 1.0f;
+
+	// Character spawned by the ALS.Benchmark console command. Falls back to the default pawn of the game mode.
+	UPROPERTY(EditAnywhere, Config, Category = "Benchmark")
+	TSoftClassPtr<AALSBaseCharacter> BenchmarkCharacterClass;
+
 	static FORCEINLINE UALS_Settings* Get()
 	{
 		UALS_Settings* Settings = GetMutableDefault<UALS_Settings>();
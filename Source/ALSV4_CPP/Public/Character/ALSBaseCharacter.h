@@ -9,6 +9,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/TimelineComponent.h"
+#include "Library/ALSAnimationStructLibrary.h"
 #include "Library/ALSCharacterEnumLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
 #include "Engine/DataTable.h"
@@ -19,8 +20,61 @@ class UTimelineComponent;
 class UAnimInstance;
 class UAnimMontage;
 class UALSCharacterAnimInstance;
+class UALSCurveCacheSubsystem;
+class UALSCharacterTickSubsystem;
+struct FALSMovementModel;
+struct FALSMovementModelEntry;
 enum class EVisibilityBasedAnimTickOption : uint8;
 
+/** Target of the grounded rotation while moving, see SmoothCharacterRotation */
+struct FALSGroundedRotationTarget
+{
+	bool bValid = false;
+
+	/** Looking direction rotation adds the YawOffset anim curve to the yaw, which is read when the target is applied */
+	float Yaw = 0.0f;
+
+	bool bAddYawOffsetCurve = false;
+
+	float TargetInterpSpeed = 0.0f;
+
+	float ActorInterpSpeed = 0.0f;
+};
+
+/** Locomotion values evaluated for this character by the parallel phase of the batched character tick */
+struct FALSLocomotionFrame
+{
+	/** Frame and delta time the values were evaluated for. They're only valid for a tick with the same ones. */
+	uint64 FrameCounter = 0;
+
+	float DeltaSeconds = 0.0f;
+
+	/** State the values were evaluated with. If the state changed before the tick, the tick evaluates them itself. */
+	EALSMovementState MovementState = EALSMovementState::None;
+
+	EALSMovementAction MovementAction = EALSMovementAction::None;
+
+	EALSRotationMode RotationMode = EALSRotationMode::VelocityDirection;
+
+	EALSStance Stance = EALSStance::Standing;
+
+	EALSGait DesiredGait = EALSGait::GaitNormal;
+
+	bool bHasMovementValues = false;
+
+	EALSGait AllowedGait = EALSGait::GaitNormal;
+
+	EALSGait ActualGait = EALSGait::GaitNormal;
+
+	bool bHasRotationValues = false;
+
+	float MappedSpeed = 0.0f;
+
+	float GroundedRotationRate = 0.0f;
+
+	FALSGroundedRotationTarget RotationTarget;
+};
+
 /*
  * Base character class
  */
@@ -29,6 +83,9 @@ class ALSV4_CPP_API AALSBaseCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
+	friend class UALSCharacterTickSubsystem;
+	friend class UALSCharacterMovementComponent;
+
 public:
 	AALSBaseCharacter(const FObjectInitializer& ObjectInitializer);
 
@@ -42,8 +99,24 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PreInitializeComponents() override;
 
+	virtual void PostNetReceive() override;
+
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget,
+								 UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget,
+								  const FVector& SrcLocation) const override;
+
+	/** Distance bucket of the character seen from a viewer, see UALS_Settings::bUseReplicationBuckets */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Replication")
+	EALSReplicationBucket GetReplicationBucket(const FVector& ViewLocation) const;
+
 	virtual void PostInitializeComponents() override;
 
 	virtual void NotifyHit(UPrimitiveComponent* MyComp, AActor* Other, UPrimitiveComponent* OtherComp, bool bSelfMoved,
@@ -68,6 +141,10 @@ public:
 	UFUNCTION(BlueprintCallable, Server, Unreliable, Category = "ALS|Ragdoll System")
 	void Server_SetMeshLocationDuringRagdoll(FVector MeshLocation);
 
+	/** Sends a ragdoll snapshot of the owning client to the server, see UALS_Settings::bUseRagdollSnapshots */
+	UFUNCTION(Server, Unreliable)
+	void Server_SetRagdollSnapshot(const FALSRagdollSnapshot& Snapshot);
+
 	/** Character States */
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
@@ -103,24 +180,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void SetRotationMode(EALSRotationMode NewRotationMode);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_SetRotationMode(EALSRotationMode NewRotationMode);
-
 	UFUNCTION(BlueprintCallable, Category = "ALS|Input")
 	void SetFlightMode(EALSFlightMode NewFlightMode);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_SetFlightMode(EALSFlightMode NewFlightMode);
-
 	UFUNCTION(BlueprintGetter, Category = "ALS|Character States")
 	EALSRotationMode GetRotationMode() const { return RotationMode; }
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void SetOverlayState(EALSOverlayState NewState);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_SetOverlayState(EALSOverlayState NewState);
-
 	UFUNCTION(BlueprintGetter, Category = "ALS|Character States")
 	EALSOverlayState GetOverlayState() const { return OverlayState; }
 
@@ -133,28 +201,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void EventOnLanded();
 
-	UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "ALS|Character States")
+	/** Cosmetic, not sent to connections in the far replication bucket */
+	UFUNCTION(BlueprintCallable, NetMulticast, Unreliable, Category = "ALS|Character States")
 	void Multicast_OnLanded();
 
 	/** On Jumped*/
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void EventOnJumped();
 
-	UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "ALS|Character States")
+	/** Cosmetic, not sent to connections in the far replication bucket */
+	UFUNCTION(BlueprintCallable, NetMulticast, Unreliable, Category = "ALS|Character States")
 	void Multicast_OnJumped();
 
-	/** Rolling Montage Play Replication*/
+	/** Rolling Montage Play Replication, plays the montage on the server and replicates it through ReplicatedMontage */
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
 	void Server_PlayMontage(UAnimMontage* Montage, float Track);
 
-	UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "ALS|Character States")
-	void Multicast_PlayMontage(UAnimMontage* Montage, float Track);
-
-	/** Mantling*/
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
-							EALSMantleType MantleType);
-
+	/** Mantling, started by the server on the simulated proxies. Owning clients predict their mantles. */
 	UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "ALS|Character States")
 	void Multicast_MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
 							   EALSMantleType MantleType);
@@ -186,24 +249,15 @@ public:
 	UFUNCTION(BlueprintSetter, Category = "ALS|Input")
 	void SetDesiredStance(EALSStance NewStance);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Input")
-	void Server_SetDesiredStance(EALSStance NewStance);
-
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void SetDesiredGait(EALSGait NewGait);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_SetDesiredGait(EALSGait NewGait);
-
 	UFUNCTION(BlueprintGetter, Category = "ALS|Input")
 	EALSRotationMode GetDesiredRotationMode() const { return DesiredRotationMode; }
 
 	UFUNCTION(BlueprintSetter, Category = "ALS|Input")
 	void SetDesiredRotationMode(EALSRotationMode NewRotMode);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_SetDesiredRotationMode(EALSRotationMode NewRotMode);
-
 	// Utility function to determine the indended movement direction.
 	UFUNCTION(BlueprintCallable, Category = "ALS|Input")
 	virtual FVector GetMovementDirection() const { return FVector::ZeroVector; }
@@ -240,6 +294,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
 	FALSMovementSettings GetTargetMovementSettings() const;
 
+	/** Row of the movement model data table */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
+	FALSMovementStateSettings GetMovementData() const;
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
 	EALSGait GetAllowedGait() const;
 
@@ -330,12 +388,41 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Essential Information")
 	void SetAimYawRate(float NewAimYawRate);
 
+	/** Hands this frame's state over to the anim instance in a single snapshot. Called once at the end of Tick. */
+	void PublishAnimCharacterInformation();
+
+	/** Idle Tick Rate */
+
+	/** True while the character ticks at UALS_Settings::IdleTickInterval */
+	FORCEINLINE bool IsIdle() const { return bIdle; }
+
+	/** Checked every frame while idle by the movement component, which keeps ticking at the full rate */
+	bool ShouldWakeFromIdle() const;
+
+	/** Restores the full tick rate, and restarts the idle delay */
+	void WakeFromIdle();
+
 protected:
 	/** Ragdoll System */
 
 	void RagdollUpdate(float DeltaTime);
 	void SetActorLocationDuringRagdoll(float DeltaTime);
 
+	/** Sends a snapshot of the simulated pelvis, if the snapshot interval has passed */
+	void SendRagdollSnapshot();
+
+	void ReceiveRagdollSnapshot(const FALSRagdollSnapshot& Snapshot);
+
+	UFUNCTION()
+	void OnRep_RagdollSnapshot();
+
+	/**
+	 * Plays the replicated montage from where it is on the server, unless it already finished. Waits for the server
+	 * world time to catch up with the start time first.
+	 */
+	UFUNCTION()
+	void OnRep_ReplicatedMontage();
+
 	/** State Changes */
 	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
 	virtual void OnMovementStateChanged(EALSMovementState PreviousState);
@@ -358,6 +445,42 @@ protected:
 
 	void SetEssentialValues(float DeltaTime);
 
+	/** Runs the movement and rotation updates of the current movement state */
+	void UpdateLocomotion(float DeltaTime);
+
+	/**
+	 * Runs the locomotion in fixed steps of 1 / UALS_Settings::FixedLocomotionStepRate, as many as are due this frame.
+	 * Rendered instances interpolate the rotation between the last two steps: simulated proxies on the actor, locally
+	 * controlled characters on the mesh only.
+	 */
+	void TickFixedStepLocomotion(float DeltaTime);
+
+	/** Puts the mesh back to its base offset from the capsule, if the fixed step interpolation rotated it */
+	void ResetMeshStepRotation();
+
+	/** Lowers the tick rate once the character stood still for UALS_Settings::IdleDelay, wakes it up otherwise */
+	void UpdateIdleState(float DeltaTime);
+
+	UFUNCTION()
+	void OnAnimMontageStarted(UAnimMontage* Montage);
+
+	/** Parallel Locomotion */
+
+	/**
+	 * Sets the essential values and evaluates the gaits and grounded rotation of this frame into LocomotionFrame.
+	 * Only writes to this character, so it is safe to call for several characters at once from worker threads.
+	 */
+	void EvaluateLocomotionFrame(float DeltaTime);
+
+	/** True if the essential values of this tick were already set by EvaluateLocomotionFrame */
+	FORCEINLINE bool HasLocomotionFrame(const float DeltaTime) const
+	{
+		return LocomotionFrame.FrameCounter == GFrameCounter && LocomotionFrame.DeltaSeconds == DeltaTime;
+	}
+
+	/** True if the gaits and rotation of LocomotionFrame can be used, the state hasn't changed since they were evaluated */
+	bool CanUseLocomotionFrame(float DeltaTime) const;
+
 	void UpdateCharacterMovement(float DeltaTime);
 
 	// Adjusts walking speed to account for player temperature and ground incline, where extremes of each slow movement.
@@ -414,19 +537,42 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "ALS|Mantle System")
 	bool CanMantle(EALSMantleType Type);
 
-	UFUNCTION()
-	virtual void MantleUpdate(float BlendIn);
+	/**
+	 * Updates the mantle target of moving ledges and returns the character transform at a playback position of the
+	 * mantle. Called by the movement component, which advances the playback position with its moves.
+	 */
+	virtual FTransform MantleUpdate(float PlaybackPosition);
 
-	UFUNCTION()
 	virtual void MantleEnd();
 
+	/** Starts a mantle predicted by the owning client if the server agrees it's possible, rolls the client back if not */
+	void StartPredictedMantle(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
+							  EALSMantleType MantleType);
+
+	/**
+	 * Server side check of a mantle predicted by the owning client, against the server state. Only repeats the downward
+	 * trace and the room check of MantleCheck, at the ledge the client sent.
+	 */
+	virtual bool ValidateMantle(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
+								EALSMantleType MantleType);
+
+	/** Rolls back a predicted mantle the server rejected */
+	UFUNCTION(Client, Reliable)
+	void Client_RejectMantle();
+
 	/** Utils */
 
 	float GetMappedSpeed() const;
 
+	/** Maps the current speed with the given movement settings instead of the current ones */
+	float GetMappedSpeed(const FALSMovementSettings& MovementSettings) const;
+
 	void SmoothCharacterRotation(FRotator Target, float TargetInterpSpeed, float ActorInterpSpeed, float DeltaTime);
 
 	float CalculateGroundedRotationRate() const;
+
+	/** Target of the grounded rotation while moving, for the given gait and rotation rate */
+	FALSGroundedRotationTarget GetGroundedRotationTarget(EALSGait CurrentGait, float GroundedRotationRate) const;
 	float CalculateFlightRotationRate() const;
 
 	void UpdateRelativeAltitude();
@@ -439,7 +585,38 @@ protected:
 
 	void SetMovementModel();
 
+	/** Points TargetMovementEntry at the movement model entry of the current state. Called when the state changes. */
+	void UpdateTargetMovementSettings();
+
+	/** Copies the target movement settings into CurrentMovementSettings, if they changed since the last copy */
+	void ApplyTargetMovementSettings();
+
+	/**
+	 * Evaluates the movement curve of the current settings at the mapped speed. With change driven movement settings,
+	 * the mapped speed is quantized into buckets and false is returned if the bucket, settings and movement mode are
+	 * the same as in the last call, in which case the movement component already has the curve values.
+	 */
+	bool EvaluateMovementCurve(FVector& OutCurveVec);
+
 	/** Replication */
+
+	/** Copies the states into ReplicatedStates, done on the server before each replication */
+	void SyncReplicatedStates();
+
+	/** Sends the given fields of PendingServerStates to the server at the end of the tick */
+	void RequestServerStates(uint8 Fields);
+
+	/** Applies the changed client states on the server, batched into one call per frame */
+	UFUNCTION(Server, Reliable)
+	void Server_SetStates(const FALSReplicatedStates& States);
+
+	/** Applies the replicated states and dispatches the handlers of the ones that changed */
+	UFUNCTION()
+	void OnRep_ReplicatedStates();
+
+	/** Sets the net update frequency from the bucket of the nearest connection viewing the character */
+	void UpdateReplicationBucket();
+
 	UFUNCTION()
 	void OnRep_RotationMode(EALSRotationMode PrevRotMode);
 
@@ -465,13 +642,14 @@ protected:
 
 	/** Input */
 
-	UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "ALS|Input")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
 	EALSRotationMode DesiredRotationMode = EALSRotationMode::LookingDirection;
 
-	UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "ALS|Input")
+	/** Replicated to the owner only, everyone else gets it in ReplicatedStates */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "ALS|Input")
 	EALSGait DesiredGait = EALSGait::GaitNormal;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "ALS|Input")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
 	EALSStance DesiredStance = EALSStance::Standing;
 
 	/** Movement System */
@@ -482,8 +660,21 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Movement System")
 	FDataTableRowHandle MovementModel;
 
-	UPROPERTY(BlueprintReadOnly, Category = "ALS|Movement System")
-	FALSMovementStateSettings MovementData;
+	/** Row of MovementModel, shared with all characters using the same row. Set in SetMovementModel. */
+	TSharedPtr<const FALSMovementModel> SharedMovementModel;
+
+	/** Entry of the current state in SharedMovementModel */
+	const FALSMovementModelEntry* TargetMovementEntry = nullptr;
+
+	/** Entry last copied into CurrentMovementSettings */
+	const FALSMovementModelEntry* AppliedMovementEntry = nullptr;
+
+	/** Mapped speed bucket, settings and movement mode the movement component curve values were last written for */
+	int32 MovementCurveBucket = INDEX_NONE;
+
+	const FALSMovementModelEntry* MovementCurveEntry = nullptr;
+
+	TEnumAsByte<EMovementMode> MovementCurveMode = MOVE_None;
 
 	// How much walking speed is affected by the incline of the floor.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Movement System")
@@ -495,6 +686,7 @@ protected:
 
 	/** Components */
 
+	/** No longer drives the mantle, the movement component does. Kept so that assets referencing it still load. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Components")
 	UTimelineComponent* MantleTimeline = nullptr;
 
@@ -529,15 +721,17 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
 	float EasedMaxAcceleration = 0.0f;
 
+	/** Replicated with 1 decimal of precision. Only updated past UALS_Settings::ReplicatedAccelerationThreshold. */
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Essential Information")
-	FVector ReplicatedCurrentAcceleration = FVector::ZeroVector;
+	FVector_NetQuantize10 ReplicatedCurrentAcceleration = FVector::ZeroVector;
 
+	/** Only updated past UALS_Settings::ReplicatedControlRotationThreshold */
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Essential Information")
 	FRotator ReplicatedControlRotation = FRotator::ZeroRotator;
 
 	/** State Values */
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_OverlayState)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values")
 	EALSOverlayState OverlayState = EALSOverlayState::Default;
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
@@ -549,12 +743,31 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
 	EALSMovementAction MovementAction = EALSMovementAction::None;
 
-	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_RotationMode)
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
 	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_FlightMode)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values")
 	EALSFlightMode FlightMode = EALSFlightMode::None;
 
+	/**
+	 * Desired states, rotation mode, overlay state and flight mode, replicated to everyone but the owner. The owner
+	 * still receives DesiredGait on its own, so gait changes made by the server reach it.
+	 */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedStates)
+	FALSReplicatedStates ReplicatedStates;
+
+	/** States changed by the owning client since the last Server_SetStates */
+	FALSReplicatedStates PendingServerStates;
+
+	/** Bucket of the nearest connection viewing the character, updated on the server before each replication */
+	EALSReplicationBucket ReplicationBucket = EALSReplicationBucket::Near;
+
+	/** Net update frequency the character is configured with, used for the near bucket */
+	float NearNetUpdateFrequency = 0.0f;
+
+	/** Set while a cosmetic multicast is sent, so that IsNetRelevantFor can leave out far connections */
+	bool bSendingCosmeticEvent = false;
+
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
 	EALSGait Gait = EALSGait::GaitSlow;
 
@@ -659,6 +872,10 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
 	FTransform MantleAnimatedStartOffset = FTransform::Identity;
 
+	/** Length of the mantle playback, the correction curve minus the starting position */
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
+	float MantleLength = 0.0f;
+
 	/**  Enables automatically vaulting over short obstacles, when moving toward them. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	bool bUseAutoVault = true;
@@ -711,6 +928,23 @@ protected:
 	/* Server ragdoll pull force storage*/
 	float ServerRagdollPull = 0.0f;
 
+	/** Newest ragdoll snapshot, replicated instead of TargetRagdollLocation with ragdoll snapshots */
+	UPROPERTY(ReplicatedUsing = OnRep_RagdollSnapshot)
+	FALSRagdollSnapshot ReplicatedRagdollSnapshot;
+
+	/** Snapshots received from the machine simulating the ragdoll */
+	FALSRagdollSnapshotBuffer RagdollSnapshots;
+
+	/** World time the last ragdoll snapshot was sent at */
+	float LastRagdollSnapshotTime = 0.0f;
+
+	/** Last montage played through Replicated_PlayMontage, replicated to everyone but the owner */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedMontage)
+	FALSReplicatedMontage ReplicatedMontage;
+
+	/** Retries OnRep_ReplicatedMontage until the server world time reached the montage start time */
+	FTimerHandle ReplicatedMontageRetryTimer;
+
 	/* Dedicated server mesh default visibility based anim tick option*/
 	EVisibilityBasedAnimTickOption DefVisBasedTickOp;
 
@@ -723,6 +957,50 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Cached Variables")
 	UALSCharacterAnimInstance* MainAnimInstance = nullptr;
 
+	/** State handed over to the anim instance once per frame, see PublishAnimCharacterInformation */
+	FALSAnimCharacterInformation AnimCharacterInformation;
+
+	UPROPERTY()
+	UALSCurveCacheSubsystem* CurveCache = nullptr;
+
+	/** Batched tick this character is registered to, if UALS_Settings::bUseBatchedCharacterTick is enabled */
+	UPROPERTY()
+	UALSCharacterTickSubsystem* CharacterTickSubsystem = nullptr;
+
+	/** Slot of this character in the batched tick, INDEX_NONE while it ticks on its own */
+	int32 BatchedTickIndex = INDEX_NONE;
+
+	/** Values evaluated by the parallel phase of the batched tick, if UALS_Settings::bUseParallelLocomotion is enabled */
+	FALSLocomotionFrame LocomotionFrame;
+
+	/** Idle tick rate state, see UALS_Settings::bUseIdleTickRate */
+	bool bIdle = false;
+
+	/** Time the character has been standing still for */
+	float IdleTime = 0.0f;
+
+	/** Time since the last tick by the batched tick, which holds idle characters back itself */
+	float IdleSkippedTime = 0.0f;
+
+	/** Tick intervals to restore when waking up */
+	float ActiveActorTickInterval = 0.0f;
+
+	float ActiveMeshTickInterval = 0.0f;
+
+	/** Fixed step locomotion state, see UALS_Settings::bUseFixedStepLocomotion */
+	float LocomotionStepAccumulator = 0.0f;
+
+	/** Actor rotation after the last two steps */
+	FRotator StepRotation = FRotator::ZeroRotator;
+
+	FRotator PreviousStepRotation = FRotator::ZeroRotator;
+
+	/** Actor rotation set by the interpolation on simulated proxies, anything else rotating the character resets it */
+	FRotator InterpolatedStepRotation = FRotator::ZeroRotator;
+
+	/** Mesh rotated away from its base offset by the interpolation on locally controlled characters */
+	bool bMeshStepRotationOffset = false;
+
 	/* Timer to manage reset of braking friction factor after on landed event */
 	FTimerHandle OnLandedFrictionResetTimer;
 
@@ -7,6 +7,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
 #include "ALSCharacterMovementComponent.generated.h"
 
 /**
@@ -17,6 +19,19 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 {
 	GENERATED_UCLASS_BODY()
 
+	/** A mantle the owning client started, sent to the server with the move it starts on */
+	struct FALSMantleRequest
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+
+		// Quantized with QuantizeMantleTarget
+		FTransform Target = FTransform::Identity;
+
+		float Height = 0.0f;
+
+		EALSMantleType Type = EALSMantleType::HighMantle;
+	};
+
 	class FSavedMove_Faerie : public FSavedMove_Character
 	{
 	public:
@@ -25,11 +40,60 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 
 		virtual void Clear() override;
 		virtual uint8 GetCompressedFlags() const override;
+		virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter,
+									float MaxDelta) const override;
+		virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC,
+								 const FVector& OldStartLocation) override;
 		virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel,
 								class FNetworkPredictionData_Client_Character& ClientData) override;
+		virtual void PrepMoveFor(ACharacter* Character) override;
+		virtual bool IsImportantMove(const FSavedMovePtr& LastAckedMove) const override;
 
 		// Walk Speed Update
 		uint8 bSavedRequestMovementSettingsChange : 1;
+
+		// Requested max speeds, already quantized
+		float SavedMaxWalkSpeed = 0.0f;
+		float SavedMaxFlySpeed = 0.0f;
+		float SavedMaxSwimSpeed = 0.0f;
+
+		// Mantle progress at the start of the move, restored when the move is replayed
+		float SavedMantlePlaybackPosition = 0.0f;
+
+		// The mantle this move starts, if any
+		uint8 bSavedMantleRequest : 1;
+		FALSMantleRequest SavedMantleRequest;
+	};
+
+	/** Move data sent to the server, carries the requested max speeds of the move */
+	class FALSCharacterNetworkMoveData : public FCharacterNetworkMoveData
+	{
+	public:
+
+		typedef FCharacterNetworkMoveData Super;
+
+		virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove,
+											   ENetworkMoveType MoveType) override;
+		virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap,
+							   ENetworkMoveType MoveType) override;
+
+		float MaxWalkSpeed = 0.0f;
+		float MaxFlySpeed = 0.0f;
+		float MaxSwimSpeed = 0.0f;
+
+		bool bHasMantleRequest = false;
+		FALSMantleRequest MantleRequest;
+
+	private:
+		static void SerializeMantleRequest(FArchive& Ar, UPackageMap* PackageMap, FALSMantleRequest& Request);
+	};
+
+	class FALSCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+	{
+	public:
+		FALSCharacterNetworkMoveDataContainer();
+
+		FALSCharacterNetworkMoveData MoveData[3];
 	};
 
 	class FNetworkPredictionData_Client_Faerie : public FNetworkPredictionData_Client_Character
@@ -45,33 +109,66 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 public:
 
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+								const FVector& NewAccel) override;
 	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 	virtual void OnMovementUpdated(float DeltaTime, const FVector& OldLocation, const FVector& OldVelocity) override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType,
+							   FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Custom movement mode the character mantles in
+	static constexpr uint8 MantleCustomMode = 0;
+
+	// Switches to the mantle movement mode, the owning character has to be set up by MantleStart first
+	void StartMantle();
+
+	// Sends a mantle the owning client started to the server, with the next move (Called from the owning client)
+	void RequestMantle(float Height, const FALSComponentAndTransform& LedgeWS, EALSMantleType Type);
+
+	// Drops the mantle from the moves that weren't acknowledged yet, after the server rejected it
+	void RejectMantle();
+
+	bool IsMantling() const { return MovementMode == MOVE_Custom && CustomMovementMode == MantleCustomMode; }
+
+	// Rounds a mantle target to the precision it's sent to the server with
+	static FTransform QuantizeMantleTarget(const FTransform& Target);
 
 
 	// Movement Settings Variables
 	uint8 bRequestMovementSettingsChange = 1;
 
-	float MyNewMaxWalkSpeed, MyNewMaxFlySpeed, MyNewMaxSwimSpeed = 0;
+	float MyNewMaxWalkSpeed = 0, MyNewMaxFlySpeed = 0, MyNewMaxSwimSpeed = 0;
+
+	// Rounds a max speed to the precision it's sent to the server with, 1/4 unit up to 16383.75.
+	static FORCEINLINE float QuantizeMaxSpeed(const float Speed)
+	{
+		return FMath::Clamp(FMath::RoundToInt(Speed * 4.0f), 0, MAX_uint16) / 4.0f;
+	}
 
-	// Set Max Walking Speed (Called from the owning client)
+	// Set Max Walking Speed (Called from the owning client). Sent to the server with the moves.
 	UFUNCTION(BlueprintCallable, Category = "Movement Settings")
 	void SetMaxWalkingSpeed(float NewMaxWalkSpeed);
 
-	UFUNCTION(Reliable, Server)
-	void Server_SetMaxWalkingSpeed(float NewMaxWalkSpeed);
-
-	// Set Max Flying Speed (Called from the owning client)
+	// Set Max Flying Speed (Called from the owning client). Sent to the server with the moves.
 	UFUNCTION(BlueprintCallable, Category = "Movement Settings")
 	void SetMaxFlyingSpeed(float NewMaxFlySpeed);
 
-	UFUNCTION(Reliable, Server)
-	void Server_SetMaxFlyingSpeed(float NewMaxFlySpeed);
-
-	// Set Max Simming Speed (Called from the owning client)
+	// Set Max Simming Speed (Called from the owning client). Sent to the server with the moves.
 	UFUNCTION(BlueprintCallable, Category = "Movement Settings")
 	void SetMaxSwimmingSpeed(float NewMaxSwimSpeed);
 
-	UFUNCTION(Reliable, Server)
-	void Server_SetMaxSwimmingSpeed(float NewMaxSwimSpeed);
+protected:
+	virtual void PhysCustom(float DeltaTime, int32 Iterations) override;
+
+	// Moves the character along the mantle of its owner, replayable from MantlePlaybackPosition
+	void PhysMantle(float DeltaTime, int32 Iterations);
+
+	float MantlePlaybackPosition = 0.0f;
+
+	// Mantle started since the last saved move, picked up by the next one
+	bool bHasPendingMantleRequest = false;
+	FALSMantleRequest PendingMantleRequest;
+
+private:
+	FALSCharacterNetworkMoveDataContainer ALSNetworkMoveDataContainer;
 };
@@ -0,0 +1,97 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "ALSCharacterTickSubsystem.generated.h"
+
+class AALSBaseCharacter;
+class UALSCharacterTickSubsystem;
+
+/** Tick function of the batched character tick. Ticks after the movement of the registered characters. */
+USTRUCT()
+struct FALSCharacterTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UALSCharacterTickSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+							 const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSCharacterTickFunction> : public TStructOpsTypeTraitsBase2<FALSCharacterTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Ticks all registered ALS characters from a single tick function, instead of dispatching one actor tick per
+ * character. Characters are grouped by movement state every frame, so that characters running the same code path
+ * tick back to back. Enabled with UALS_Settings::bUseBatchedCharacterTick, characters tick on their own otherwise.
+ * Registered characters ignore their actor tick interval, the batch ticks them every frame, or once per
+ * UALS_Settings::IdleTickInterval while they're idle.
+ * With UALS_Settings::bUseParallelLocomotion, the locomotion math of all characters is evaluated in parallel first,
+ * see AALSBaseCharacter::EvaluateLocomotionFrame.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSCharacterTickSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Takes over the tick of the character. Its own actor tick is disabled while it's registered. */
+	void RegisterCharacter(AALSBaseCharacter* Character);
+
+	/** Hands the tick back to the character's own actor tick */
+	void UnregisterCharacter(AALSBaseCharacter* Character);
+
+	/** Called by registered characters when their movement state changes, keeps the grouping up to date */
+	FORCEINLINE void SetMovementState(const int32 Index, const EALSMovementState NewState)
+	{
+		MovementStates[Index] = NewState;
+	}
+
+	/** Tick function everything that used to depend on the characters' actor ticks should depend on */
+	FTickFunction& GetTickFunction() { return TickFunction; }
+
+	void ExecuteTick(float DeltaTime, ELevelTick TickType);
+
+private:
+	FALSCharacterTickFunction TickFunction;
+
+	/** Registered characters and their movement states, in the same order. Unregistered slots are null until compacted. */
+	UPROPERTY()
+	TArray<AALSBaseCharacter*> Characters;
+
+	TArray<EALSMovementState> MovementStates;
+
+	/** Indices into Characters, grouped by movement state */
+	TArray<int32> TickOrder;
+
+	/** Delta time of each character in the current tick, zero for characters held back by the idle tick rate */
+	TArray<float> TickDeltaTimes;
+
+	/** Indices into Characters, of the characters evaluated by the parallel phase of the current tick */
+	TArray<int32> ParallelCharacters;
+
+	bool bHasFreeSlots = false;
+};
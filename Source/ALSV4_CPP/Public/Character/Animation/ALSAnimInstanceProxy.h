@@ -0,0 +1,40 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "ALSAnimInstanceProxy.generated.h"
+
+class UALSCharacterAnimInstance;
+
+/**
+ * Anim instance proxy for the ALS character anim instance. The character's state snapshot is swapped into the anim
+ * instance once on the game thread (PreUpdate), and all pure math of the anim update then runs in Update, which is executed
+ * on a worker thread when multi threaded animation update is enabled.
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FALSAnimInstanceProxy() {}
+
+	FALSAnimInstanceProxy(UAnimInstance* InAnimInstance) : FAnimInstanceProxy(InAnimInstance) {}
+
+protected:
+	virtual void Initialize(UAnimInstance* InAnimInstance) override;
+
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+
+	virtual void Update(float DeltaSeconds) override;
+
+private:
+	UALSCharacterAnimInstance* ALSAnimInstance = nullptr;
+};
@@ -9,14 +9,105 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "WorldCollision.h"
 #include "Library/ALSAnimationStructLibrary.h"
 #include "Library/ALSStructEnumLibrary.h"
 #include "ALSCharacterAnimInstance.generated.h"
 
 class AALSBaseCharacter;
+struct FALSAnimInstanceProxy;
 class UCurveFloat;
 class UAnimSequence;
 class UCurveVector;
+struct FALSBakedCurve;
+struct FALSAnimatedSpeeds;
+class UALSLocomotionBatchSubsystem;
+
+/** Foot IK trace state of a single foot, used when the foot IK traces are done asynchronously */
+struct FALSFootIKTrace
+{
+	/** Handle and foot location of the trace submitted in the last frame, if any */
+	FTraceHandle Handle;
+
+	FVector PendingTraceLocation = FVector::ZeroVector;
+
+	/** Last received trace result and the foot location it was traced from */
+	FHitResult HitResult;
+
+	FVector TraceLocation = FVector::ZeroVector;
+
+	/** Floor component of the character when the last trace was submitted */
+	TWeakObjectPtr<UPrimitiveComponent> FloorComponent;
+
+	bool bHasResult = false;
+};
+
+/** Grounded movement values computed for this anim instance by the locomotion batch subsystem */
+struct FALSBatchedMovementValues
+{
+	/** Frame and delta time the values were computed for. They're only valid for an update with the same ones. */
+	uint64 FrameCounter = 0;
+
+	float DeltaSeconds = 0.0f;
+
+	FALSVelocityBlend VelocityBlend;
+
+	FVector RelativeAccelerationAmount = FVector::ZeroVector;
+
+	FALSLeanAmount LeanAmount;
+
+	float DiagonalScaleAmount = 0.0f;
+
+	float StrideBlend = 0.0f;
+
+	float StandingPlayRate = 0.0f;
+
+	float CrouchingPlayRate = 0.0f;
+};
+
+/** Anim graph values blended in between the updates of a reduced rate anim LOD tier */
+struct FALSAnimLODValues
+{
+	FALSVelocityBlend VelocityBlend;
+
+	FALSLeanAmount LeanAmount;
+
+	FVector RelativeAccelerationAmount = FVector::ZeroVector;
+
+	FVector2D SmoothedAimingAngle = FVector2D::ZeroVector;
+
+	FALSAnimGraphAimingValues AimingValues;
+
+	FALSAnimGraphGrounded Grounded;
+
+	FALSAnimGraphInAir InAir;
+
+	FALSAnimGraphLayerBlending LayerBlendingValues;
+
+	FALSAnimGraphFootIK FootIKValues;
+
+	float FlailRate = 0.0f;
+};
+
+/** Land prediction sweep state, used when the land prediction sweep is done asynchronously */
+struct FALSLandPredictionSweep
+{
+	/** Handle and path of the sweep submitted in the last frame, if any */
+	FTraceHandle Handle;
+
+	FVector PendingStart = FVector::ZeroVector;
+
+	FVector PendingEnd = FVector::ZeroVector;
+
+	/** Last received sweep result and the path it was swept along */
+	FHitResult HitResult;
+
+	FVector SweepStart = FVector::ZeroVector;
+
+	FVector SweepEnd = FVector::ZeroVector;
+
+	bool bHasResult = false;
+};
 
 /**
  * Main anim instance class for character
@@ -26,11 +117,24 @@ class ALSV4_CPP_API UALSCharacterAnimInstance : public UAnimInstance
 {
 	GENERATED_BODY()
 
+	friend struct FALSAnimInstanceProxy;
+	friend class UALSLocomotionBatchSubsystem;
+
 public:
 	virtual void NativeInitializeAnimation() override;
 
+	virtual void NativeUninitializeAnimation() override;
+
+	/** Game thread part of the update. Only scene queries and timer/montage calls are done here. */
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
 
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
+public:
+
 	UFUNCTION(BlueprintCallable, Category = "Play Animation")
 	void PlayTransition(const FALSDynamicMontageParams& Parameters);
 
@@ -88,8 +192,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Grounded")
 	bool CanDynamicTransition() const;
 
-	/** Return mutable reference of character information to edit them easily inside character class */
-	FALSAnimCharacterInformation& GetCharacterInformationMutable() { return CharacterInformation; }
+	/** Anim curves read by the last anim update */
+	const FALSAnimCurveValues& GetCurveValues() const { return CurveValues; }
+
+	/** Hands over the character's state of this frame. It's swapped in when the next anim update starts. */
+	void PublishCharacterInformation(const FALSAnimCharacterInformation& NewCharacterInformation);
+
+	/** Swaps in the last published character information, if a new one was published since. Game thread only. */
+	void ConsumeCharacterInformation();
 
 private:
 	void PlayDynamicTransitionDelay();
@@ -98,8 +208,20 @@ private:
 
 	void OnPivotDelay();
 
+	/** Worker thread part of the update, called from the anim instance proxy. Must not touch the character. */
+	void NativeWorkerUpdateAnimation(float DeltaSeconds);
+
 	/** Update Values */
 
+	void UpdateAnimLOD(float DeltaSeconds);
+
+	void CaptureAnimLODValues(FALSAnimLODValues& OutValues) const;
+
+	/** Sets the anim graph values between two captures. Flags and states, which notifies and timers set, are kept. */
+	void BlendAnimLODValues(const FALSAnimLODValues& From, const FALSAnimLODValues& To, float Alpha);
+
+	void UpdateCurveValues();
+
 	void UpdateAimingValues(float DeltaSeconds);
 
 	void UpdateLayerValues();
@@ -110,13 +232,15 @@ private:
 
 	void UpdateRotationValues();
 
-	void UpdateInAirValues(float DeltaSeconds);
+	void UpdateInAirValues();
+
+	void UpdateInAirLeanValues(float DeltaSeconds);
 
 	void UpdateRagdollValues();
 
 	/** Foot IK */
 
-	void SetFootLocking(float DeltaSeconds, FName EnableFootIKCurve, FName FootLockCurve, FName IKFootBone,
+	void SetFootLocking(float DeltaSeconds, float EnableFootIKCurve, float FootLockCurve, FName IKFootBone,
 						float& CurFootLockAlpha, bool& UseFootLockCurve, FVector& CurFootLockLoc,
 						FRotator& CurFootLockRot) const;
 
@@ -126,8 +250,11 @@ private:
 
 	void ResetIKOffsets(float DeltaSeconds);
 
-	void SetFootOffsets(float DeltaSeconds, FName EnableFootIKCurve, FName IKFootBone, FName RootBone,
-						FVector& CurLocationTarget, FVector& CurLocationOffset, FRotator& CurRotationOffset) const;
+	void SetFootOffsets(float DeltaSeconds, float EnableFootIKCurve, FName IKFootBone, FName RootBone,
+						FALSFootIKTrace& FootIKTrace, FVector& CurLocationTarget, FVector& CurLocationOffset,
+						FRotator& CurRotationOffset) const;
+
+	bool TraceFootFloor(const FVector& IKFootFloorLoc, FALSFootIKTrace& FootIKTrace, FHitResult& OutHitResult) const;
 
 	/** Grounded */
 
@@ -155,7 +282,11 @@ private:
 
 	float CalculateCrouchingPlayRate() const;
 
-	float CalculateLandPrediction() const;
+	float CalculateLandPrediction();
+
+	bool SweepLandPrediction(const FVector& Start, const FVector& TraceLength, bool bAsync, FHitResult& OutHitResult);
+
+	float GetLandPredictionWeight(const FHitResult& HitResult) const;
 
 	FALSLeanAmount CalculateAirLeanAmount() const;
 
@@ -163,7 +294,10 @@ private:
 
 	/** Util */
 
-	float GetAnimCurveClamped(const FName& Name, float Bias, float ClampMin, float ClampMax) const;
+	static float GetAnimCurveClamped(float CurveValue, float Bias, float ClampMin, float ClampMax);
+
+	/** Animated speeds of Config, for FALSLocomotionCore */
+	FALSAnimatedSpeeds GetAnimatedSpeeds() const;
 
 protected:
 	/** References */
@@ -233,6 +367,14 @@ protected:
 		ShowOnlyInnerProperties))
 	FALSAnimGraphLayerBlending LayerBlendingValues;
 
+	/** Anim LOD tier picked for this frame, see UALS_Settings::AnimLODTiers */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Anim LOD")
+	int32 AnimLODTier = 0;
+
+	/** Anim Curves, read once per frame before any of the update functions run */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Anim Curves", Meta = (ShowOnlyInnerProperties))
+	FALSAnimCurveValues CurveValues;
+
 	/** Anim Graph - Foot IK */
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Anim Graph - Foot IK", Meta = (ShowOnlyInnerProperties))
 	FALSAnimGraphFootIK FootIKValues;
@@ -282,6 +424,69 @@ protected:
 	UAnimSequenceBase* TransitionAnim_L = nullptr;
 
 private:
+	/** Back buffer of CharacterInformation, written by the character once per frame */
+	FALSAnimCharacterInformation PublishedCharacterInformation;
+
+	bool bHasPublishedCharacterInformation = false;
+
+	/** NativeWorkerUpdateAnimation already ran on the game thread in this frame, see UALS_Settings::bUseAnimWorkerUpdate */
+	bool bWorkerUpdateOnGameThread = false;
+
+	/** Curve names mapped to the value they are read into, resolved once in NativeInitializeAnimation */
+	TMap<FName, float FALSAnimCurveValues::*> CurveHandles;
+
+	FALSFootIKTrace FootIKTrace_L;
+
+	FALSFootIKTrace FootIKTrace_R;
+
+	FALSLandPredictionSweep LandPredictionSweep;
+
+	/** Baked tables of the blend curves, found on the game thread in NativeInitializeAnimation */
+	const FALSBakedCurve* BakedDiagonalScaleAmountCurve = nullptr;
+
+	const FALSBakedCurve* BakedStrideBlend_N_Walk = nullptr;
+
+	const FALSBakedCurve* BakedStrideBlend_N_Run = nullptr;
+
+	const FALSBakedCurve* BakedStrideBlend_C_Walk = nullptr;
+
+	const FALSBakedCurve* BakedLandPredictionCurve = nullptr;
+
+	const FALSBakedCurve* BakedLeanInAirCurve = nullptr;
+
+	const FALSBakedCurve* BakedYawOffset_FB = nullptr;
+
+	const FALSBakedCurve* BakedYawOffset_LR = nullptr;
+
+	/** Results of the locomotion batch, if this instance is registered to it */
+	FALSBatchedMovementValues BatchedMovementValues;
+
+	/** Frame the curve values were last read in, they may be read early by the locomotion batch */
+	uint64 CurveValuesFrameCounter = 0;
+
+	/** Features allowed by the current anim LOD tier */
+	FALSAnimLODTier AnimLODFeatures;
+
+	/** Reduced rate updates of the anim LOD tiers */
+	uint32 AnimLODFrameCounter = 0;
+
+	float AnimLODSkippedTime = 0.0f;
+
+	float AnimLODDeltaSeconds = 0.0f;
+
+	bool bSkipAnimLODUpdate = false;
+
+	/** Values shown before the last reduced rate update, and the ones it computed. Blended over the skipped frames. */
+	FALSAnimLODValues AnimLODFromValues;
+
+	FALSAnimLODValues AnimLODTargetValues;
+
+	int32 AnimLODBlendFrame = 0;
+
+	int32 AnimLODBlendFrames = 1;
+
+	bool bAnimLODBlending = false;
+
 	FTimerHandle OnPivotTimer;
 
 	FTimerHandle PlayDynamicTransitionTimer;
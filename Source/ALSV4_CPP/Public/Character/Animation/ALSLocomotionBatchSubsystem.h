@@ -0,0 +1,109 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ALSLocomotionBatchSubsystem.generated.h"
+
+class UALSCharacterAnimInstance;
+class UALSLocomotionBatchSubsystem;
+
+/** Tick function of the locomotion batch. Ticks after the registered characters, and before their meshes. */
+USTRUCT()
+struct FALSLocomotionBatchTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UALSLocomotionBatchSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+							 const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSLocomotionBatchTickFunction> : public TStructOpsTypeTraitsBase2<
+		FALSLocomotionBatchTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Structure of arrays layout of the grounded movement values of all batched characters.
+ * Every array is padded to a multiple of 4, so that the kernel can always work on full vector registers.
+ */
+struct FALSLocomotionBatchData
+{
+	typedef TArray<float, TAlignedHeapAllocator<16>> FLane;
+
+	int32 Num = 0;
+
+	/** Inputs */
+	FLane DeltaSeconds;
+	FLane VelocityX, VelocityY, VelocityZ;
+	FLane AccelerationX, AccelerationY, AccelerationZ;
+	/** Actor rotation axes, unrotating a vector is a dot product with each of them */
+	FLane AxisXX, AxisXY, AxisXZ;
+	FLane AxisYX, AxisYY, AxisYZ;
+	FLane AxisZX, AxisZY, AxisZZ;
+	FLane MaxAcceleration, MaxBrakingDeceleration;
+	FLane Speed, MeshScale, StrideBlend, WeightGait;
+	FLane AnimatedWalkSpeed, AnimatedRunSpeed, AnimatedSprintSpeed, AnimatedCrouchSpeed;
+	FLane VelocityBlendInterpSpeed, GroundedLeanInterpSpeed;
+
+	/** Current values as inputs, interpolated values as outputs */
+	FLane BlendF, BlendB, BlendL, BlendR;
+	FLane LeanLR, LeanFB;
+
+	/** Outputs */
+	FLane RelativeAccelerationX, RelativeAccelerationY, RelativeAccelerationZ;
+	FLane StandingPlayRate, CrouchingPlayRate;
+
+	/** Resets the batch to hold Count characters, padding lanes are filled with harmless values */
+	void Reset(int32 Count);
+};
+
+/**
+ * Runs the pure grounded movement math of all registered ALS anim instances in one batch: velocity blend,
+ * relative acceleration, lean interpolation and play rates. Inputs are gathered into structure of arrays lanes,
+ * processed 4 characters at a time with vector intrinsics, and scattered back into each anim instance,
+ * which then skips the per character version of that math. Enabled with UALS_Settings::bUseBatchedLocomotion.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSLocomotionBatchSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterAnimInstance(UALSCharacterAnimInstance* AnimInstance);
+
+	void UnregisterAnimInstance(UALSCharacterAnimInstance* AnimInstance);
+
+	void ExecuteBatch(float DeltaTime);
+
+	/** Vectorized kernel, works on the first Data.Num characters of the batch */
+	static void RunKernel(FALSLocomotionBatchData& Data);
+
+private:
+	FALSLocomotionBatchTickFunction BatchTickFunction;
+
+	TArray<TWeakObjectPtr<UALSCharacterAnimInstance>> AnimInstances;
+
+	/** Anim instances of the current batch, in the order of the batch lanes */
+	TArray<UALSCharacterAnimInstance*> BatchedInstances;
+
+	FALSLocomotionBatchData BatchData;
+};
@@ -125,9 +125,36 @@ struct FALSAnimCharacterInformation
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
 	float ZoomAmount = 0.0f;
 
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float MaxAcceleration = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float MaxBrakingDeceleration = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float MeshScale = 1.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	EALSMovementState MovementState = EALSMovementState::None;
+
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
 	EALSMovementState PrevMovementState = EALSMovementState::None;
 
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	EALSMovementAction MovementAction = EALSMovementAction::None;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	EALSGait Gait = EALSGait::GaitSlow;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	EALSStance Stance = EALSStance::Standing;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
 	EALSViewMode ViewMode = EALSViewMode::ThirdPerson;
 };
@@ -370,6 +397,81 @@ struct FALSAnimGraphFootIK
 	float PelvisAlpha = 0.0f;
 };
 
+USTRUCT(BlueprintType)
+struct FALSAnimCurveValues
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Enable_Transition = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Mask_AimOffset = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float BasePose_N = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float BasePose_CLF = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Spine_Add = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Head_Add = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Arm_L_Add = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Arm_R_Add = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Hand_R = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Hand_L = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Enable_HandIK_L = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Arm_L = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Enable_HandIK_R = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Arm_R = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Arm_L_LS = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Layering_Arm_R_LS = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Enable_FootIK_L = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Enable_FootIK_R = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float FootLock_L = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float FootLock_R = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float RotationAmount = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Weight_Gait = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Animation Struct Library")
+	float Mask_LandPrediction = 0.0f;
+};
+
 USTRUCT(BlueprintType)
 struct FALSAnimTurnInPlace
 {
@@ -442,6 +544,44 @@ struct FALSAnimRotateInPlace
 	float MaxPlayRate = 3.0f;
 };
 
+USTRUCT(BlueprintType)
+struct FALSAnimLODTier
+{
+	GENERATED_BODY()
+
+	/** Characters further away from the closest local view than this distance can't use this tier */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	float MaxDistance = 0.0f;
+
+	/** Characters smaller on screen than this size (bounds radius relative to the view's half width) can't use this tier */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	float MinScreenSize = 0.0f;
+
+	/**
+	 * Update the anim instance only every Nth frame. Skipped time is carried over to the next update, and the anim graph
+	 * values blend toward the ones of the last update over the skipped frames.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library", Meta = (ClampMin = 1))
+	int32 UpdateInterval = 1;
+
+	/** Foot locking, foot offset traces and pelvis offset */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	bool bFootIK = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	bool bDynamicTransitions = true;
+
+	/** Turn in place and rotate in place checks */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	bool bTurnInPlace = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	bool bAimSmoothing = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	bool bLandPrediction = true;
+};
+
 USTRUCT(BlueprintType)
 struct FALSAnimConfiguration
 {
@@ -489,4 +629,30 @@ struct FALSAnimConfiguration
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
 	float IK_TraceDistanceBelowFoot = 45.0f;
+
+	/** Submit foot IK traces asynchronously and use their results on the next frame */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	bool bUseAsyncFootIKTraces = false;
+
+	/**
+	 * In async mode, the last trace result is reused while the foot moved less than this distance
+	 * and the character is still standing on the same floor component
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library", Meta = (EditCondition = "bUseAsyncFootIKTraces"))
+	float IK_TraceReuseDistance = 2.0f;
+
+	/** Submit land prediction sweeps asynchronously, and extrapolate the last result while the trajectory stays the same */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library")
+	bool bUseAsyncLandPrediction = false;
+
+	/** In async mode, re-sweep if the fall direction turned more than this angle (in degrees) since the last sweep */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library", Meta = (EditCondition = "bUseAsyncLandPrediction"))
+	float LandPredictionResweepAngle = 5.0f;
+
+	/**
+	 * In async mode, re-sweep if the character drifted sideways from the last swept path,
+	 * or if the current trace reaches past the end of the last sweep by more than this distance
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation Struct Library", Meta = (EditCondition = "bUseAsyncLandPrediction"))
+	float LandPredictionResweepDistance = 10.0f;
 };
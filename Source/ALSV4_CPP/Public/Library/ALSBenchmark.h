@@ -0,0 +1,193 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Library/ALSStats.h"
+#include "ALSBenchmark.generated.h"
+
+class AALSBaseCharacter;
+class AController;
+class UNetConnection;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAlsBenchmark, Log, All)
+
+/** Settings the benchmark comparisons change, saved when the benchmark starts and restored when it ends */
+struct FALSBenchmarkSettings
+{
+	bool bUseAnimWorkerUpdate = true;
+
+	bool bReadAnimCurvesInOnePass = true;
+
+	float ReplicatedAccelerationThreshold = 0.0f;
+
+	float ReplicatedControlRotationThreshold = 0.0f;
+};
+
+/** Benchmark options, see the ALS.Benchmark console command */
+struct FALSBenchmarkOptions
+{
+	TArray<int32> CharacterCounts = {1, 50, 200, 500};
+
+	int32 WarmupFrames = 60;
+
+	int32 MeasuredFrames = 600;
+
+	/** Scripted phase all characters stay in, e.g. only ragdolls. INDEX_NONE cycles through all of them. */
+	int32 Phase = INDEX_NONE;
+
+	/**
+	 * Setting compared by the benchmark, e.g. the anim worker update. Every count then runs twice, with the setting
+	 * disabled (before) and enabled (after). INDEX_NONE runs every count once with the current settings.
+	 */
+	int32 Comparison = INDEX_NONE;
+
+	TSubclassOf<AALSBaseCharacter> CharacterClass;
+
+	FString OutputPath;
+
+	bool bQuitWhenDone = false;
+};
+
+/**
+ * Spawns increasing numbers of characters driven by scripted input (walking, sprinting, falling, flight, mantling
+ * and ragdoll), measures the world tick, AALSBaseCharacter::Tick, UALSCharacterAnimInstance::NativeUpdateAnimation
+ * and the scene queries issued by ALS for every frame, and writes the results as JSON for regression tracking.
+ * Runs headless, e.g. -game -nullrhi -ExecCmds="ALS.Benchmark Quit".
+ *
+ * Compare=<Setting> measures an optimization before and after: every count runs with the setting disabled, then
+ * enabled. E.g. Compare=AnimWorker shows the game thread time the anim worker update saves per character, and
+ * Compare=CurveReads the cost of reading the anim curves by name against reading them in one pass.
+ * Compare=ReplicationThresholds runs with the replicated acceleration and control rotation thresholds at zero, then
+ * at their configured values. Run it on a server with clients connected to get the bandwidth each of them saves.
+ *
+ * Run on a server it doubles as a replication soak test: the report then has the game thread time, which includes
+ * the net driver, and the bandwidth of every client connection. Start a server with -server -nullrhi, connect a few
+ * local clients with "127.0.0.1 -game -nullrhi", and run the benchmark on the server once they're in.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSBenchmarkSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Starts the benchmark. Returns false if one is already running, or no character class is available */
+	bool StartBenchmark(const FALSBenchmarkOptions& InOptions);
+
+	bool IsRunning() const { return bRunning; }
+
+private:
+	struct FScriptedCharacter
+	{
+		TWeakObjectPtr<AALSBaseCharacter> Character;
+
+		TWeakObjectPtr<AController> Controller;
+
+		FVector Direction = FVector::ForwardVector;
+
+		float PhaseOffset = 0.0f;
+
+		int32 Phase = INDEX_NONE;
+	};
+
+	struct FConnectionSamples
+	{
+		TWeakObjectPtr<UNetConnection> Connection;
+
+		FString Address;
+
+		int32 StartInBytes = 0;
+
+		int32 StartOutBytes = 0;
+
+		int32 InBytes = 0;
+
+		int32 OutBytes = 0;
+	};
+
+	struct FRunSamples
+	{
+		int32 CharacterCount = 0;
+
+		/** Value of the compared setting during the run, if the benchmark compares one */
+		bool bComparedSetting = false;
+
+		float MeasuredSeconds = 0.0f;
+
+		TArray<float> WorldTickMs;
+
+		TArray<float> GameThreadMs;
+
+		TArray<float> CharacterTickMs;
+
+		TArray<float> AnimUpdateMs;
+
+		TArray<float> CurveReadMs;
+
+		TArray<float> SceneQueries;
+
+		/** Land prediction checks, see UALS_Settings::bVerifyAsyncLandPrediction */
+		float LandPredictionMaxDeviation = 0.0f;
+
+		int32 LandPredictionDeviations = 0;
+
+		TArray<FConnectionSamples> Connections;
+	};
+
+	void OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	/** Number of runs, every count runs twice when comparing a setting */
+	int32 GetRunCount() const;
+
+	/** Sets up the compared setting for the run at RunIndex and spawns its characters */
+	void StartRun();
+
+	void SpawnCharacters(int32 Count);
+
+	void DestroyCharacters();
+
+	void DriveCharacters(float DeltaSeconds);
+
+	/** Snapshots the traffic of the client connections, when the measured frames of a run start */
+	void StartConnectionSamples();
+
+	/** Stores the traffic of the client connections since StartConnectionSamples */
+	void FinishConnectionSamples();
+
+	void Finish();
+
+	void WriteReport() const;
+
+	FALSBenchmarkOptions Options;
+
+	TArray<FScriptedCharacter> ScriptedCharacters;
+
+	TArray<FRunSamples> Runs;
+
+	FDelegateHandle TickStartHandle;
+
+	FDelegateHandle PostActorTickHandle;
+
+	int32 RunIndex = INDEX_NONE;
+
+	int32 RunFrame = 0;
+
+	float ScriptTime = 0.0f;
+
+	uint64 TickStartCycles = 0;
+
+	/** Compared settings before the benchmark started, restored when it ends */
+	FALSBenchmarkSettings InitialSettings;
+
+	bool bRunning = false;
+};
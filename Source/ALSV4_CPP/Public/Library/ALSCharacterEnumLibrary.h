@@ -167,3 +167,11 @@ enum class EALSMovementDirection : uint8
 	Left,
 	Backward
 };
+
+UENUM(BlueprintType)
+enum class EALSReplicationBucket : uint8
+{
+	Near,
+	Mid,
+	Far
+};
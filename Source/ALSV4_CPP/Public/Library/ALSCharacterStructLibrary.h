@@ -10,6 +10,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataTable.h"
+#include "Engine/NetSerialization.h"
 #include "Library/ALSCharacterEnumLibrary.h"
 
 #include "ALSCharacterStructLibrary.generated.h"
@@ -31,6 +32,184 @@ struct FALSComponentAndTransform
 	class UPrimitiveComponent* Component = nullptr;
 };
 
+/**
+ * The replicated states of a character, packed into one property and one server RPC. Each field is sent with as few
+ * bits as its enum needs. FieldMask only selects fields for Server_SetStates, the replicated property always has all
+ * of them.
+ */
+USTRUCT()
+struct FALSReplicatedStates
+{
+	GENERATED_BODY()
+
+	static constexpr uint8 DesiredGaitField = 1 << 0;
+	static constexpr uint8 DesiredStanceField = 1 << 1;
+	static constexpr uint8 DesiredRotationModeField = 1 << 2;
+	static constexpr uint8 RotationModeField = 1 << 3;
+	static constexpr uint8 OverlayStateField = 1 << 4;
+	static constexpr uint8 FlightModeField = 1 << 5;
+	static constexpr uint8 AllFields = (1 << 6) - 1;
+
+	UPROPERTY()
+	EALSGait DesiredGait = EALSGait::GaitNormal;
+
+	UPROPERTY()
+	EALSStance DesiredStance = EALSStance::Standing;
+
+	UPROPERTY()
+	EALSRotationMode DesiredRotationMode = EALSRotationMode::LookingDirection;
+
+	UPROPERTY()
+	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
+
+	UPROPERTY()
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+
+	UPROPERTY()
+	EALSFlightMode FlightMode = EALSFlightMode::None;
+
+	/**
+	 * Fields set in this struct, only meaningful for Server_SetStates where the client sends the changed ones. Always
+	 * AllFields in the replicated property, since property replication already skips it while nothing changed.
+	 */
+	UPROPERTY()
+	uint8 FieldMask = 0;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+	{
+		SerializeField(Ar, FieldMask, AllFields);
+		if (FieldMask & DesiredGaitField) { SerializeField(Ar, DesiredGait, EALSGait::GaitFast); }
+		if (FieldMask & DesiredStanceField) { SerializeField(Ar, DesiredStance, EALSStance::Riding); }
+		if (FieldMask & DesiredRotationModeField) { SerializeField(Ar, DesiredRotationMode, EALSRotationMode::Aiming); }
+		if (FieldMask & RotationModeField) { SerializeField(Ar, RotationMode, EALSRotationMode::Aiming); }
+		if (FieldMask & OverlayStateField) { SerializeField(Ar, OverlayState, EALSOverlayState::Barrel); }
+		if (FieldMask & FlightModeField) { SerializeField(Ar, FlightMode, EALSFlightMode::Hovering); }
+
+		bOutSuccess = !Ar.IsError();
+		return true;
+	}
+
+private:
+	/** Serializes a value in the bits needed for 0 to MaxValue */
+	template <typename T>
+	static void SerializeField(FArchive& Ar, T& Value, const T MaxValue)
+	{
+		uint32 IntValue = static_cast<uint32>(Value);
+		Ar.SerializeInt(IntValue, static_cast<uint32>(MaxValue) + 1);
+		Value = static_cast<T>(IntValue);
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSReplicatedStates> : public TStructOpsTypeTraitsBase2<FALSReplicatedStates>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+/** Pelvis location and velocity of a ragdoll, sent by the machine simulating it */
+USTRUCT(BlueprintType)
+struct FALSRagdollSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Ragdoll System")
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Ragdoll System")
+	FVector_NetQuantize Velocity = FVector::ZeroVector;
+
+	/** Changes with every snapshot, so that the snapshots of a resting ragdoll still replicate */
+	UPROPERTY()
+	uint8 Sequence = 0;
+};
+
+/** The locomotion montage a character plays, replicated so that proxies and late joiners can pick it up midway */
+USTRUCT()
+struct FALSReplicatedMontage
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UAnimMontage* Montage = nullptr;
+
+	/** Server world time the montage started at */
+	UPROPERTY()
+	float StartTime = 0.0f;
+
+	UPROPERTY()
+	float PlayRate = 1.0f;
+
+	/** Changes with every play, so that playing the same montage again still replicates */
+	UPROPERTY()
+	uint8 Sequence = 0;
+};
+
+/** The last ragdoll snapshots received, stamped with the local time they arrived at */
+struct FALSRagdollSnapshotBuffer
+{
+	static constexpr int32 Capacity = 4;
+
+	void Reset() { Num = 0; }
+
+	bool IsEmpty() const { return Num == 0; }
+
+	void Add(const FALSRagdollSnapshot& Snapshot, const float Time)
+	{
+		Head = (Head + 1) % Capacity;
+		Snapshots[Head] = Snapshot;
+		Times[Head] = Time;
+		Num = FMath::Min(Num + 1, Capacity);
+	}
+
+	/** Seconds since the newest snapshot arrived */
+	float GetAge(const float Time) const { return IsEmpty() ? BIG_NUMBER : Time - Times[Head]; }
+
+	/**
+	 * Pelvis location at the given time, interpolated between the snapshots around it, or extrapolated from the newest
+	 * one for at most MaxExtrapolation seconds. Returns false if the buffer is empty.
+	 */
+	bool Sample(const float Time, const float MaxExtrapolation, FVector& OutLocation) const
+	{
+		if (IsEmpty()) { return false; }
+
+		const FALSRagdollSnapshot& Newest = Snapshots[Head];
+		if (Time >= Times[Head])
+		{
+			OutLocation = Newest.Location + Newest.Velocity * FMath::Min(Time - Times[Head], MaxExtrapolation);
+			return true;
+		}
+
+		// Step back from the newest snapshot until the time is between two of them
+		int32 Next = Head;
+		for (int32 Step = 1; Step < Num; ++Step)
+		{
+			const int32 Prev = (Head - Step + Capacity) % Capacity;
+			if (Time >= Times[Prev])
+			{
+				const float Alpha = (Time - Times[Prev]) / FMath::Max(Times[Next] - Times[Prev], KINDA_SMALL_NUMBER);
+				OutLocation = FMath::Lerp<FVector>(Snapshots[Prev].Location, Snapshots[Next].Location, Alpha);
+				return true;
+			}
+			Next = Prev;
+		}
+
+		OutLocation = Snapshots[Next].Location;
+		return true;
+	}
+
+private:
+	FALSRagdollSnapshot Snapshots[Capacity];
+
+	float Times[Capacity] = {};
+
+	int32 Head = 0;
+
+	int32 Num = 0;
+};
+
 USTRUCT(BlueprintType)
 struct FALSCameraSettings
 {
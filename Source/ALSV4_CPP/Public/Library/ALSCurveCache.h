@@ -0,0 +1,79 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ALSCurveCache.generated.h"
+
+class UCurveBase;
+class UCurveFloat;
+class UCurveVector;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAlsCurveCache, Log, All)
+
+/**
+ * A curve resampled into a fixed resolution table. Float curves only use the X channel.
+ * Once baked, a table is never modified, so it can be evaluated from any thread.
+ */
+struct ALSV4_CPP_API FALSBakedCurve
+{
+	TArray<FVector> Samples;
+
+	float MinTime = 0.0f;
+
+	float InvStep = 0.0f;
+
+	/** Largest difference to the source curve found while baking */
+	float MaxError = 0.0f;
+
+	FORCEINLINE FVector Evaluate(const float Time) const
+	{
+		// Samples are clamped at both ends, which matches the constant extrapolation of the source curve
+		const int32 LastIndex = Samples.Num() - 1;
+		const float Position = FMath::Clamp((Time - MinTime) * InvStep, 0.0f, static_cast<float>(LastIndex));
+		const int32 Index = FMath::Min(FMath::TruncToInt(Position), LastIndex - 1);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - static_cast<float>(Index));
+	}
+};
+
+/**
+ * Shared cache of baked locomotion curves. Curves are baked once per world the first time they're requested,
+ * so edits to the curve assets are picked up by the next play session.
+ * Curves that can't be represented within UALS_Settings::BakedCurveMaxError are always evaluated exactly.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSCurveCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Returns the baked table of the curve, baking it if needed. Returns nullptr if the curve is null,
+	 * baked curves are disabled, or the curve must be evaluated exactly. Game thread only.
+	 */
+	const FALSBakedCurve* FindOrBake(const UCurveBase* Curve);
+
+	/** Game thread only, use the static versions with a table found in advance on other threads */
+	float GetFloatValue(const UCurveFloat* Curve, float Time);
+
+	FVector GetVectorValue(const UCurveVector* Curve, float Time);
+
+	static float GetFloatValue(const UCurveFloat* Curve, const FALSBakedCurve* BakedCurve, float Time);
+
+	static FVector GetVectorValue(const UCurveVector* Curve, const FALSBakedCurve* BakedCurve, float Time);
+
+	virtual void Deinitialize() override;
+
+private:
+	static TUniquePtr<FALSBakedCurve> Bake(const UCurveBase* Curve);
+
+	/** Tables are owned here and never removed while the world lives, so the returned pointers stay valid */
+	TMap<TObjectKey<UCurveBase>, TUniquePtr<FALSBakedCurve>> BakedCurves;
+};
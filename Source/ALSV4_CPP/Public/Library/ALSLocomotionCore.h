@@ -0,0 +1,358 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Plain copies of the ALS enums, the locomotion core doesn't depend on the engine. The values match the UENUMs, see
+ * ALSLocomotionCoreConversion.h for the conversions.
+ */
+enum class EALSCoreGait : uint8_t
+{
+	Slow,
+	Normal,
+	Fast
+};
+
+enum class EALSCoreStance : uint8_t
+{
+	Standing,
+	Crouching,
+	Riding
+};
+
+enum class EALSCoreRotationMode : uint8_t
+{
+	VelocityDirection,
+	LookingDirection,
+	Aiming
+};
+
+enum class EALSCoreFlightMode : uint8_t
+{
+	None,
+	Neutral,
+	Raising,
+	Lowering,
+	Hovering
+};
+
+enum class EALSCoreMovementDirection : uint8_t
+{
+	Forward,
+	Right,
+	Left,
+	Backward
+};
+
+/** Plain vector, see FVector */
+struct FALSCoreVector
+{
+	float X = 0.0f;
+
+	float Y = 0.0f;
+
+	float Z = 0.0f;
+};
+
+/** Configured speeds of a movement settings entry, see FALSMovementSettings */
+struct FALSGaitSpeeds
+{
+	float SlowSpeed = 0.0f;
+
+	float NormalSpeed = 0.0f;
+
+	float FastSpeed = 0.0f;
+};
+
+/** Inputs of the sprint check, gathered from the character */
+struct FALSSprintInputs
+{
+	EALSCoreRotationMode RotationMode = EALSCoreRotationMode::VelocityDirection;
+
+	bool bHasMovementInput = false;
+
+	float MovementInputAmount = 0.0f;
+
+	/** Yaw of the movement input relative to the aiming rotation, normalized. Only read in LookingDirection. */
+	float InputAimYawDelta = 0.0f;
+};
+
+/** Speeds the locomotion cycles were authored at, see FALSAnimConfiguration */
+struct FALSAnimatedSpeeds
+{
+	float WalkSpeed = 150.0f;
+
+	float RunSpeed = 350.0f;
+
+	float SprintSpeed = 600.0f;
+
+	float CrouchSpeed = 150.0f;
+};
+
+/** Directional weights of the velocity, see FALSVelocityBlend */
+struct FALSDirectionalBlend
+{
+	float F = 0.0f;
+
+	float B = 0.0f;
+
+	float L = 0.0f;
+
+	float R = 0.0f;
+};
+
+/** Lean amounts, see FALSLeanAmount */
+struct FALSLeanValues
+{
+	float LR = 0.0f;
+
+	float FB = 0.0f;
+};
+
+/**
+ * The pure math of the character and anim instance updates. Takes plain values instead of reading them from the
+ * character, has no state and only depends on the standard library, so it can run on any thread and be built, tested
+ * and profiled outside of the engine (see Tests/LocomotionCore). The scalar functions are constexpr.
+ */
+struct FALSLocomotionCore
+{
+	/** Same as SMALL_NUMBER */
+	static constexpr float SmallNumber = 1.e-8f;
+
+	/** Same as KINDA_SMALL_NUMBER */
+	static constexpr float KindaSmallNumber = 1.e-4f;
+
+	/** Same as FMath::GetMappedRangeValueClamped */
+	static constexpr float MapRangeClamped(const float InMin, const float InMax, const float OutMin,
+										   const float OutMax, const float Value)
+	{
+		const float Divisor = InMax - InMin;
+		const float Pct = (Divisor < SmallNumber && Divisor > -SmallNumber)
+							  ? (Value >= InMax ? 1.0f : 0.0f)
+							  : (Value - InMin) / Divisor;
+		const float ClampedPct = Pct < 0.0f ? 0.0f : (Pct > 1.0f ? 1.0f : Pct);
+		return OutMin + ClampedPct * (OutMax - OutMin);
+	}
+
+	static constexpr float Clamp(const float Value, const float Min, const float Max)
+	{
+		return Value < Min ? Min : (Value > Max ? Max : Value);
+	}
+
+	static constexpr float Abs(const float Value) { return Value < 0.0f ? -Value : Value; }
+
+	static constexpr float Lerp(const float A, const float B, const float Alpha) { return A + Alpha * (B - A); }
+
+	/** Character Gaits */
+
+	/**
+	 * Maps the speed to the configured movement speeds with a range of 0-3, with 0 = stopped, 1 = the Slow Speed,
+	 * 2 = the Normal Speed, and 3 = the Fast Speed.
+	 */
+	static constexpr float GetMappedSpeed(const float Speed, const FALSGaitSpeeds& Speeds)
+	{
+		return Speed > Speeds.NormalSpeed
+				   ? MapRangeClamped(Speeds.NormalSpeed, Speeds.FastSpeed, 2.0f, 3.0f, Speed)
+				   : Speed > Speeds.SlowSpeed
+				   ? MapRangeClamped(Speeds.SlowSpeed, Speeds.NormalSpeed, 1.0f, 2.0f, Speed)
+				   : MapRangeClamped(0.0f, Speeds.SlowSpeed, 0.0f, 1.0f, Speed);
+	}
+
+	/**
+	 * Only allow sprinting with full movement input. In the Looking Rotation mode, the input also has to face forward
+	 * relative to the camera + or - 50 degrees.
+	 */
+	static constexpr bool CanSprint(const FALSSprintInputs& Inputs)
+	{
+		return Inputs.bHasMovementInput && Inputs.RotationMode != EALSCoreRotationMode::Aiming &&
+			Inputs.MovementInputAmount > 0.9f &&
+			(Inputs.RotationMode == EALSCoreRotationMode::VelocityDirection ||
+				(Inputs.RotationMode == EALSCoreRotationMode::LookingDirection && Abs(Inputs.InputAimYawDelta) < 50.0f));
+	}
+
+	/** The maximum Gait the character is currently allowed to be in. Only standing and not aiming allows sprinting. */
+	static constexpr EALSCoreGait GetAllowedGait(const EALSCoreStance Stance, const EALSCoreRotationMode RotationMode,
+												 const EALSCoreGait DesiredGait, const bool bCanSprint)
+	{
+		return DesiredGait != EALSCoreGait::Fast
+				   ? DesiredGait
+				   : Stance == EALSCoreStance::Standing && RotationMode != EALSCoreRotationMode::Aiming && bCanSprint
+				   ? EALSCoreGait::Fast
+				   : EALSCoreGait::Normal;
+	}
+
+	/** The Gait of the actual movement, can differ from the allowed gait while the character decelerates */
+	static constexpr EALSCoreGait GetActualGait(const float Speed, const FALSGaitSpeeds& Speeds,
+												const EALSCoreGait AllowedGait)
+	{
+		return Speed > Speeds.NormalSpeed + 10.0f
+				   ? (AllowedGait == EALSCoreGait::Fast ? EALSCoreGait::Fast : EALSCoreGait::Normal)
+				   : Speed >= Speeds.SlowSpeed + 10.0f
+				   ? EALSCoreGait::Normal
+				   : EALSCoreGait::Slow;
+	}
+
+	/** Flight */
+
+	/** Downward force of the wings keeping the character afloat. Zero if the character doesn't fly. */
+	static constexpr float CalculateAutoHover(const EALSCoreFlightMode FlightMode, const float GroundPressure,
+											  const float FlightStrengthActive, const float TemperatureAffect,
+											  const float WeightAffect)
+	{
+		return FlightMode == EALSCoreFlightMode::Neutral
+				   ? (GroundPressure + 0.5f) / 1.5f * TemperatureAffect * WeightAffect
+				   : FlightMode == EALSCoreFlightMode::Raising
+				   ? (GroundPressure + FlightStrengthActive) * TemperatureAffect * (WeightAffect * 1.5f)
+				   : FlightMode == EALSCoreFlightMode::Lowering
+				   ? (GroundPressure * 0.5f) + (-FlightStrengthActive + (TemperatureAffect - 1.0f)) + -WeightAffect
+				   : FlightMode == EALSCoreFlightMode::Hovering
+				   ? (GroundPressure + 0.5f) / 1.5f * TemperatureAffect * (WeightAffect / 2.0f)
+				   : 0.0f;
+	}
+
+	/** Input */
+
+	/** Scales one gamepad axis up on the diagonals, so a full diagonal input reaches full speed */
+	static constexpr float FixDiagonalGamepadAxis(const float Value, const float OtherValue)
+	{
+		return Clamp(Value * MapRangeClamped(0.0f, 0.6f, 1.0f, 1.2f, Abs(OtherValue)), -1.0f, 1.0f);
+	}
+
+	/** Movement Direction */
+
+	static constexpr bool AngleInRange(const float Angle, const float MinAngle, const float MaxAngle,
+									   const float Buffer, const bool IncreaseBuffer)
+	{
+		return IncreaseBuffer
+				   ? Angle >= MinAngle - Buffer && Angle <= MaxAngle + Buffer
+				   : Angle >= MinAngle + Buffer && Angle <= MaxAngle - Buffer;
+	}
+
+	/**
+	 * Take the input angle and determine its quadrant (direction). Use the current Movement Direction to increase or
+	 * decrease the buffers on the angle ranges for each quadrant.
+	 */
+	static constexpr EALSCoreMovementDirection CalculateQuadrant(const EALSCoreMovementDirection Current,
+																 const float FRThreshold, const float FLThreshold,
+																 const float BRThreshold, const float BLThreshold,
+																 const float Buffer, const float Angle)
+	{
+		return AngleInRange(Angle, FLThreshold, FRThreshold, Buffer,
+							Current != EALSCoreMovementDirection::Forward ||
+							Current != EALSCoreMovementDirection::Backward)
+				   ? EALSCoreMovementDirection::Forward
+				   : AngleInRange(Angle, FRThreshold, BRThreshold, Buffer,
+								  Current != EALSCoreMovementDirection::Right ||
+								  Current != EALSCoreMovementDirection::Left)
+				   ? EALSCoreMovementDirection::Right
+				   : AngleInRange(Angle, BLThreshold, FLThreshold, Buffer,
+								  Current != EALSCoreMovementDirection::Right ||
+								  Current != EALSCoreMovementDirection::Left)
+				   ? EALSCoreMovementDirection::Left
+				   : EALSCoreMovementDirection::Backward;
+	}
+
+	/** Anim Graph */
+
+	static constexpr float GetAnimCurveClamped(const float CurveValue, const float Bias, const float ClampMin,
+											   const float ClampMax)
+	{
+		return Clamp(CurveValue + Bias, ClampMin, ClampMax);
+	}
+
+	/**
+	 * The velocity amount in each direction, normalized so that diagonals equal .5 for each direction.
+	 * RelativeVelocityDir is the velocity direction relative to the actor rotation.
+	 */
+	static constexpr FALSDirectionalBlend CalculateVelocityBlend(const FALSCoreVector& RelativeVelocityDir)
+	{
+		const float Sum = Abs(RelativeVelocityDir.X) + Abs(RelativeVelocityDir.Y) + Abs(RelativeVelocityDir.Z);
+		const float RelativeDirX = RelativeVelocityDir.X / Sum;
+		const float RelativeDirY = RelativeVelocityDir.Y / Sum;
+		return {
+			Clamp(RelativeDirX, 0.0f, 1.0f), Abs(Clamp(RelativeDirX, -1.0f, 0.0f)),
+			Abs(Clamp(RelativeDirY, -1.0f, 0.0f)), Clamp(RelativeDirY, 0.0f, 1.0f)
+		};
+	}
+
+	static constexpr float DotProduct(const FALSCoreVector& A, const FALSCoreVector& B)
+	{
+		return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+	}
+
+	/** Same as FVector::GetClampedToMaxSize */
+	static inline FALSCoreVector GetClampedToMaxSize(const FALSCoreVector& Vector, const float MaxSize)
+	{
+		if (MaxSize < KindaSmallNumber) { return {}; }
+
+		const float SizeSquared = DotProduct(Vector, Vector);
+		if (SizeSquared <= MaxSize * MaxSize) { return Vector; }
+
+		const float Scale = MaxSize / std::sqrt(SizeSquared);
+		return {Vector.X * Scale, Vector.Y * Scale, Vector.Z * Scale};
+	}
+
+	/**
+	 * The acceleration normalized to a range of -1 to 1 so that -1 equals the Max Braking Deceleration, and 1 equals
+	 * the Max Acceleration. The result is in the space of the inputs, unrotate it by the actor rotation to get the
+	 * relative amount.
+	 */
+	static inline FALSCoreVector CalculateAccelerationAmount(const FALSCoreVector& Acceleration,
+															 const FALSCoreVector& Velocity,
+															 const float MaxAcceleration,
+															 const float MaxBrakingDeceleration)
+	{
+		const float MaxAmount = DotProduct(Acceleration, Velocity) > 0.0f ? MaxAcceleration : MaxBrakingDeceleration;
+		const FALSCoreVector Clamped = GetClampedToMaxSize(Acceleration, MaxAmount);
+		return {Clamped.X / MaxAmount, Clamped.Y / MaxAmount, Clamped.Z / MaxAmount};
+	}
+
+	/** Blends the walk and run stride curve values by the gait, then towards the crouch stride by the base pose */
+	static constexpr float CalculateStrideBlend(const float WalkStride, const float RunStride,
+												const float CrouchWalkStride, const float WeightGait,
+												const float BasePoseCLF)
+	{
+		return Lerp(Lerp(WalkStride, RunStride, GetAnimCurveClamped(WeightGait, -1.0f, 0.0f, 1.0f)),
+					CrouchWalkStride, BasePoseCLF);
+	}
+
+	/**
+	 * Divides the speed by the animated speed of each gait, blended by the "Weight_Gait" curve so that the play rate is
+	 * always in sync with the currently blended animation. Smaller strides and meshes play faster.
+	 */
+	static constexpr float CalculateStandingPlayRate(const float Speed, const FALSAnimatedSpeeds& AnimatedSpeeds,
+													 const float WeightGait, const float StrideBlend,
+													 const float MeshScale)
+	{
+		return Clamp((Lerp(Lerp(Speed / AnimatedSpeeds.WalkSpeed, Speed / AnimatedSpeeds.RunSpeed,
+								GetAnimCurveClamped(WeightGait, -1.0f, 0.0f, 1.0f)),
+						   Speed / AnimatedSpeeds.SprintSpeed,
+						   GetAnimCurveClamped(WeightGait, -2.0f, 0.0f, 1.0f)) / StrideBlend) / MeshScale,
+					 0.0f, 3.0f);
+	}
+
+	static constexpr float CalculateCrouchingPlayRate(const float Speed, const FALSAnimatedSpeeds& AnimatedSpeeds,
+													  const float StrideBlend, const float MeshScale)
+	{
+		return Clamp(Speed / AnimatedSpeeds.CrouchSpeed / StrideBlend / MeshScale, 0.0f, 2.0f);
+	}
+
+	/**
+	 * How much the character leans in air. RelativeVelocity is the velocity relative to the actor rotation, and
+	 * LeanInAirValue the Lean In Air curve at the fall speed, which reverses the lean when the character starts falling.
+	 */
+	static constexpr FALSLeanValues CalculateAirLeanAmount(const float RelativeVelocityX,
+														   const float RelativeVelocityY,
+														   const float LeanInAirValue)
+	{
+		return {RelativeVelocityY / 350.0f * LeanInAirValue, RelativeVelocityX / 350.0f * LeanInAirValue};
+	}
+};
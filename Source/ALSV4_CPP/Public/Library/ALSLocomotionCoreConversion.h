@@ -0,0 +1,68 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSLocomotionCore.h"
+
+static_assert(uint8(EALSGait::GaitSlow) == uint8(EALSCoreGait::Slow) &&
+			  uint8(EALSGait::GaitNormal) == uint8(EALSCoreGait::Normal) &&
+			  uint8(EALSGait::GaitFast) == uint8(EALSCoreGait::Fast), "EALSCoreGait must match EALSGait");
+static_assert(uint8(EALSStance::Standing) == uint8(EALSCoreStance::Standing) &&
+			  uint8(EALSStance::Crouching) == uint8(EALSCoreStance::Crouching) &&
+			  uint8(EALSStance::Riding) == uint8(EALSCoreStance::Riding), "EALSCoreStance must match EALSStance");
+static_assert(uint8(EALSRotationMode::VelocityDirection) == uint8(EALSCoreRotationMode::VelocityDirection) &&
+			  uint8(EALSRotationMode::LookingDirection) == uint8(EALSCoreRotationMode::LookingDirection) &&
+			  uint8(EALSRotationMode::Aiming) == uint8(EALSCoreRotationMode::Aiming),
+			  "EALSCoreRotationMode must match EALSRotationMode");
+static_assert(uint8(EALSFlightMode::None) == uint8(EALSCoreFlightMode::None) &&
+			  uint8(EALSFlightMode::Neutral) == uint8(EALSCoreFlightMode::Neutral) &&
+			  uint8(EALSFlightMode::Raising) == uint8(EALSCoreFlightMode::Raising) &&
+			  uint8(EALSFlightMode::Lowering) == uint8(EALSCoreFlightMode::Lowering) &&
+			  uint8(EALSFlightMode::Hovering) == uint8(EALSCoreFlightMode::Hovering),
+			  "EALSCoreFlightMode must match EALSFlightMode");
+static_assert(uint8(EALSMovementDirection::Forward) == uint8(EALSCoreMovementDirection::Forward) &&
+			  uint8(EALSMovementDirection::Right) == uint8(EALSCoreMovementDirection::Right) &&
+			  uint8(EALSMovementDirection::Left) == uint8(EALSCoreMovementDirection::Left) &&
+			  uint8(EALSMovementDirection::Backward) == uint8(EALSCoreMovementDirection::Backward),
+			  "EALSCoreMovementDirection must match EALSMovementDirection");
+
+/** Converts the engine types to the plain types of FALSLocomotionCore and back */
+namespace ALSLocomotionCore
+{
+	constexpr EALSCoreGait ToCore(const EALSGait Gait) { return static_cast<EALSCoreGait>(Gait); }
+
+	constexpr EALSCoreStance ToCore(const EALSStance Stance) { return static_cast<EALSCoreStance>(Stance); }
+
+	constexpr EALSCoreRotationMode ToCore(const EALSRotationMode RotationMode)
+	{
+		return static_cast<EALSCoreRotationMode>(RotationMode);
+	}
+
+	constexpr EALSCoreFlightMode ToCore(const EALSFlightMode FlightMode)
+	{
+		return static_cast<EALSCoreFlightMode>(FlightMode);
+	}
+
+	constexpr EALSCoreMovementDirection ToCore(const EALSMovementDirection Direction)
+	{
+		return static_cast<EALSCoreMovementDirection>(Direction);
+	}
+
+	FORCEINLINE FALSCoreVector ToCore(const FVector& Vector) { return {Vector.X, Vector.Y, Vector.Z}; }
+
+	constexpr EALSGait FromCore(const EALSCoreGait Gait) { return static_cast<EALSGait>(Gait); }
+
+	constexpr EALSMovementDirection FromCore(const EALSCoreMovementDirection Direction)
+	{
+		return static_cast<EALSMovementDirection>(Direction);
+	}
+
+	FORCEINLINE FVector FromCore(const FALSCoreVector& Vector) { return {Vector.X, Vector.Y, Vector.Z}; }
+}
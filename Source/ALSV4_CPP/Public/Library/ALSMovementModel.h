@@ -0,0 +1,97 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+#include "ALSMovementModel.generated.h"
+
+class UDataTable;
+struct FALSBakedCurve;
+
+/** Movement settings of one state combination, with the baked tables of their curves */
+struct FALSMovementModelEntry
+{
+	FALSMovementSettings Settings;
+
+	/** Null if the curve is evaluated exactly */
+	const FALSBakedCurve* BakedMovementCurve = nullptr;
+
+	const FALSBakedCurve* BakedRotationRateCurve = nullptr;
+};
+
+/**
+ * A movement model row, resolved for every (RotationMode, MovementState, Stance) combination.
+ * Shared by all characters using the row and never modified once built, so it can be read from any thread.
+ */
+struct ALSV4_CPP_API FALSMovementModel
+{
+	static constexpr int32 RotationModeCount = static_cast<int32>(EALSRotationMode::Aiming) + 1;
+	static constexpr int32 MovementStateCount = static_cast<int32>(EALSMovementState::Ragdoll) + 1;
+	static constexpr int32 StanceCount = static_cast<int32>(EALSStance::Riding) + 1;
+	static constexpr int32 EntryCount = RotationModeCount * MovementStateCount * StanceCount;
+
+	FALSMovementStateSettings Data;
+
+	TArray<FALSMovementModelEntry> Entries;
+
+	static FORCEINLINE int32 GetEntryIndex(const EALSRotationMode RotationMode, const EALSMovementState MovementState,
+										   const EALSStance Stance)
+	{
+		return (static_cast<int32>(RotationMode) * MovementStateCount + static_cast<int32>(MovementState)) *
+			StanceCount + static_cast<int32>(Stance);
+	}
+
+	FORCEINLINE const FALSMovementModelEntry& GetEntry(const EALSRotationMode RotationMode,
+													   const EALSMovementState MovementState,
+													   const EALSStance Stance) const
+	{
+		return Entries[GetEntryIndex(RotationMode, MovementState, Stance)];
+	}
+
+	/** Settings of a state combination in the movement model, falls back to velocity direction standing */
+	static const FALSMovementSettings& SelectMovementSettings(const FALSMovementStateSettings& Data,
+															  EALSRotationMode RotationMode,
+															  EALSMovementState MovementState, EALSStance Stance);
+};
+
+/**
+ * Shared registry of movement models, keyed by data table and row name. Characters reference the models instead of
+ * copying the row, and each row is only looked up and resolved once per world. Edits to the data tables rebuild
+ * their models in editor, and the characters using them pick the new ones up through OnMovementModelsChanged.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSMovementModelSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the model of the row, building it if needed. Returns nullptr if the row doesn't exist. Game thread only. */
+	TSharedPtr<const FALSMovementModel> FindOrBuild(const FDataTableRowHandle& Handle);
+
+	virtual void Deinitialize() override;
+
+	/** Broadcast after a data table changed in editor, its models are rebuilt on the next FindOrBuild */
+	FSimpleMulticastDelegate OnMovementModelsChanged;
+
+private:
+	TSharedPtr<const FALSMovementModel> Build(const FDataTableRowHandle& Handle);
+
+#if WITH_EDITOR
+	void OnDataTableChanged(const UDataTable* DataTable);
+
+	TArray<TWeakObjectPtr<UDataTable>> WatchedDataTables;
+#endif
+
+	/** Models stay alive as long as a character references them, even after a rebuild */
+	TMap<TPair<TObjectKey<UDataTable>, FName>, TSharedPtr<const FALSMovementModel>> Models;
+};
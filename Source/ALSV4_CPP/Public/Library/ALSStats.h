@@ -0,0 +1,132 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("ALS"), STATGROUP_ALS, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Character Tick"), STAT_ALS_CharacterTick, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Character Tick"), STAT_ALS_BatchedCharacterTick, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parallel Locomotion"), STAT_ALS_ParallelLocomotion, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Set Essential Values"), STAT_ALS_SetEssentialValues, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Character Movement"), STAT_ALS_UpdateCharacterMovement, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Flight Movement"), STAT_ALS_UpdateFlightMovement, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mantle Check"), STAT_ALS_MantleCheck, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ragdoll Update"), STAT_ALS_RagdollUpdate, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Anim Update"), STAT_ALS_AnimUpdate, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Anim Worker Update"), STAT_ALS_AnimWorkerUpdate, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Foot IK"), STAT_ALS_UpdateFootIK, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Calculate Land Prediction"), STAT_ALS_CalculateLandPrediction, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Locomotion Batch"), STAT_ALS_LocomotionBatch, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Custom Camera Behavior"), STAT_ALS_CustomCameraBehavior, STATGROUP_ALS, ALSV4_CPP_API);
+
+/** Traces and sweeps issued by ALS code this frame, async ones are counted when they're submitted */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scene Queries"), STAT_ALS_SceneQueries, STATGROUP_ALS, ALSV4_CPP_API);
+
+/** Movement component parameter writes skipped this frame, see UALS_Settings::bUseChangeDrivenMovementSettings */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Skipped Movement Settings Writes"), STAT_ALS_SkippedMovementSettingsWrites,
+								  STATGROUP_ALS, ALSV4_CPP_API);
+
+/** Cosmetic multicasts not sent to a connection this frame, see UALS_Settings::bUseReplicationBuckets */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Culled Cosmetic Events"), STAT_ALS_CulledCosmeticEvents, STATGROUP_ALS,
+								  ALSV4_CPP_API);
+
+/** Async land prediction weights off the synchronous sweep this frame, see UALS_Settings::bVerifyAsyncLandPrediction */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Land Prediction Deviations"), STAT_ALS_LandPredictionDeviations, STATGROUP_ALS,
+								  ALSV4_CPP_API);
+
+/** Characters currently ticking at the idle tick rate, see UALS_Settings::bUseIdleTickRate */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Idle Characters"), STAT_ALS_IdleCharacters, STATGROUP_ALS, ALSV4_CPP_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ALSV4_CPP_API, ALS);
+
+/**
+ * Counters read by the benchmark. They're only written on the game thread, and only while a benchmark is recording.
+ */
+struct ALSV4_CPP_API FALSBenchmarkCounters
+{
+	static bool bRecording;
+
+	static uint64 CharacterTickCycles;
+
+	static uint64 AnimUpdateCycles;
+
+	static uint64 CurveReadCycles;
+
+	static int32 SceneQueries;
+
+	/** Largest difference between an async land prediction weight and the synchronous one, when verifying them */
+	static float LandPredictionMaxDeviation;
+
+	static int32 LandPredictionDeviations;
+
+	static void Reset();
+};
+
+/** Adds the cycles spent inside its scope to one of the benchmark counters */
+struct FALSBenchmarkScope
+{
+	explicit FORCEINLINE FALSBenchmarkScope(uint64& InCounter)
+		: Counter(FALSBenchmarkCounters::bRecording ? &InCounter : nullptr),
+		  StartCycles(Counter ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	FORCEINLINE ~FALSBenchmarkScope() { if (Counter) { *Counter += FPlatformTime::Cycles64() - StartCycles; } }
+
+private:
+	uint64* Counter;
+
+	uint64 StartCycles;
+};
+
+/** Instrumentation shared by the ALS hot paths */
+struct FALSStats
+{
+	/** Counts a trace or sweep for "stat ALS", CSV captures and the benchmark */
+	static FORCEINLINE void CountSceneQuery()
+	{
+		INC_DWORD_STAT(STAT_ALS_SceneQueries);
+		CSV_CUSTOM_STAT(ALS, SceneQueries, 1, ECsvCustomStatOp::Accumulate);
+		if (FALSBenchmarkCounters::bRecording) { ++FALSBenchmarkCounters::SceneQueries; }
+	}
+
+	/** Counts movement component parameters that didn't need to be written this frame */
+	static FORCEINLINE void CountSkippedMovementSettingsWrites(const int32 Count)
+	{
+		INC_DWORD_STAT_BY(STAT_ALS_SkippedMovementSettingsWrites, Count);
+		CSV_CUSTOM_STAT(ALS, SkippedMovementSettingsWrites, Count, ECsvCustomStatOp::Accumulate);
+	}
+
+	/** Counts a cosmetic multicast that wasn't sent to a connection */
+	static FORCEINLINE void CountCulledCosmeticEvent()
+	{
+		INC_DWORD_STAT(STAT_ALS_CulledCosmeticEvents);
+		CSV_CUSTOM_STAT(ALS, CulledCosmeticEvents, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	/** Records the difference between an async land prediction weight and the synchronous one */
+	static FORCEINLINE void RecordLandPredictionDeviation(const float Deviation, const float Tolerance)
+	{
+		const bool bOffTolerance = Deviation > Tolerance;
+		if (bOffTolerance)
+		{
+			INC_DWORD_STAT(STAT_ALS_LandPredictionDeviations);
+			CSV_CUSTOM_STAT(ALS, LandPredictionDeviations, 1, ECsvCustomStatOp::Accumulate);
+		}
+
+		if (FALSBenchmarkCounters::bRecording)
+		{
+			FALSBenchmarkCounters::LandPredictionMaxDeviation = FMath::Max(FALSBenchmarkCounters::LandPredictionMaxDeviation, Deviation);
+			if (bOffTolerance) { ++FALSBenchmarkCounters::LandPredictionDeviations; }
+		}
+	}
+};
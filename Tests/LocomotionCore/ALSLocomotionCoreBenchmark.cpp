@@ -0,0 +1,133 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSLocomotionCore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Times the locomotion core functions on their own, with the inputs of one character update per iteration.
+// Usage: ALSLocomotionCoreBenchmark [Iterations]
+
+namespace
+{
+	/** Inputs of one update, generated up front so the loop only measures the core */
+	struct FBenchmarkInputs
+	{
+		float Speed = 0.0f;
+
+		float Angle = 0.0f;
+
+		float WeightGait = 0.0f;
+
+		FALSCoreVector Velocity;
+
+		FALSCoreVector Acceleration;
+	};
+
+	/** Keeps the results alive, so the optimizer can't drop the work */
+	volatile float Sink = 0.0f;
+
+	std::vector<FBenchmarkInputs> MakeInputs(const int Count)
+	{
+		std::vector<FBenchmarkInputs> Inputs(Count);
+		unsigned State = 12345u;
+		const auto Random = [&State](const float Min, const float Max)
+		{
+			State = State * 1664525u + 1013904223u;
+			return Min + (Max - Min) * static_cast<float>(State >> 8) / static_cast<float>(1u << 24);
+		};
+		for (FBenchmarkInputs& Input : Inputs)
+		{
+			Input.Speed = Random(0.0f, 700.0f);
+			Input.Angle = Random(-180.0f, 180.0f);
+			Input.WeightGait = Random(1.0f, 3.0f);
+			Input.Velocity = {Random(-600.0f, 600.0f), Random(-600.0f, 600.0f), Random(-10.0f, 10.0f)};
+			Input.Acceleration = {Random(-2000.0f, 2000.0f), Random(-2000.0f, 2000.0f), 0.0f};
+		}
+		return Inputs;
+	}
+
+	template <typename FunctionType>
+	void Run(const char* Name, const std::vector<FBenchmarkInputs>& Inputs, const FunctionType& Function)
+	{
+		const auto Start = std::chrono::steady_clock::now();
+		float Result = 0.0f;
+		for (const FBenchmarkInputs& Input : Inputs) { Result += Function(Input); }
+		const auto End = std::chrono::steady_clock::now();
+		Sink = Sink + Result;
+
+		const double Nanoseconds = std::chrono::duration<double, std::nano>(End - Start).count();
+		std::printf("%-28s %10.2f ns/call\n", Name, Nanoseconds / static_cast<double>(Inputs.size()));
+	}
+}
+
+int main(const int ArgC, char** ArgV)
+{
+	const int Iterations = ArgC > 1 ? std::atoi(ArgV[1]) : 1000000;
+	if (Iterations <= 0)
+	{
+		std::printf("Usage: %s [Iterations]\n", ArgV[0]);
+		return 1;
+	}
+
+	const std::vector<FBenchmarkInputs> Inputs = MakeInputs(Iterations);
+	const FALSGaitSpeeds GaitSpeeds{165.0f, 350.0f, 600.0f};
+	const FALSAnimatedSpeeds AnimatedSpeeds;
+
+	std::printf("%d iterations\n", Iterations);
+
+	Run("GetMappedSpeed", Inputs, [&](const FBenchmarkInputs& Input)
+	{
+		return FALSLocomotionCore::GetMappedSpeed(Input.Speed, GaitSpeeds);
+	});
+
+	Run("Gaits", Inputs, [&](const FBenchmarkInputs& Input)
+	{
+		FALSSprintInputs SprintInputs;
+		SprintInputs.RotationMode = EALSCoreRotationMode::LookingDirection;
+		SprintInputs.bHasMovementInput = true;
+		SprintInputs.MovementInputAmount = 1.0f;
+		SprintInputs.InputAimYawDelta = Input.Angle;
+		const EALSCoreGait AllowedGait = FALSLocomotionCore::GetAllowedGait(
+			EALSCoreStance::Standing, SprintInputs.RotationMode, EALSCoreGait::Fast,
+			FALSLocomotionCore::CanSprint(SprintInputs));
+		return static_cast<float>(FALSLocomotionCore::GetActualGait(Input.Speed, GaitSpeeds, AllowedGait));
+	});
+
+	Run("CalculateQuadrant", Inputs, [](const FBenchmarkInputs& Input)
+	{
+		return static_cast<float>(FALSLocomotionCore::CalculateQuadrant(
+			EALSCoreMovementDirection::Forward, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Input.Angle));
+	});
+
+	Run("CalculateVelocityBlend", Inputs, [](const FBenchmarkInputs& Input)
+	{
+		const FALSDirectionalBlend Blend = FALSLocomotionCore::CalculateVelocityBlend(Input.Velocity);
+		return Blend.F + Blend.B + Blend.L + Blend.R;
+	});
+
+	Run("CalculateAccelerationAmount", Inputs, [](const FBenchmarkInputs& Input)
+	{
+		const FALSCoreVector Amount =
+			FALSLocomotionCore::CalculateAccelerationAmount(Input.Acceleration, Input.Velocity, 800.0f, 2000.0f);
+		return Amount.X + Amount.Y + Amount.Z;
+	});
+
+	Run("PlayRates", Inputs, [&](const FBenchmarkInputs& Input)
+	{
+		const float StrideBlend = FALSLocomotionCore::CalculateStrideBlend(0.5f, 0.8f, 0.6f, Input.WeightGait, 0.0f);
+		return FALSLocomotionCore::CalculateStandingPlayRate(Input.Speed, AnimatedSpeeds, Input.WeightGait,
+															 StrideBlend, 1.0f) +
+			FALSLocomotionCore::CalculateCrouchingPlayRate(Input.Speed, AnimatedSpeeds, StrideBlend, 1.0f);
+	});
+
+	return 0;
+}
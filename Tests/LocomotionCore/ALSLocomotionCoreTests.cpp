@@ -0,0 +1,213 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSLocomotionCore.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+	int Failures = 0;
+
+	void Check(const bool bCondition, const char* Expression, const char* File, const int Line)
+	{
+		if (bCondition) { return; }
+		std::printf("%s:%d: check failed: %s\n", File, Line, Expression);
+		++Failures;
+	}
+
+	bool NearlyEqual(const float A, const float B, const float Tolerance = 1.e-4f)
+	{
+		return std::fabs(A - B) <= Tolerance;
+	}
+}
+
+#define ALS_CHECK(Expression) Check((Expression), #Expression, __FILE__, __LINE__)
+#define ALS_CHECK_NEAR(A, B) Check(NearlyEqual((A), (B)), #A " == " #B, __FILE__, __LINE__)
+
+// The scalar functions stay usable in constant expressions
+static_assert(FALSLocomotionCore::MapRangeClamped(0.0f, 10.0f, 0.0f, 1.0f, 5.0f) == 0.5f, "MapRangeClamped");
+static_assert(FALSLocomotionCore::GetAllowedGait(EALSCoreStance::Standing, EALSCoreRotationMode::VelocityDirection,
+												 EALSCoreGait::Fast, true) == EALSCoreGait::Fast, "GetAllowedGait");
+
+static void TestMapRangeClamped()
+{
+	ALS_CHECK_NEAR(FALSLocomotionCore::MapRangeClamped(0.0f, 10.0f, 0.0f, 1.0f, -5.0f), 0.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::MapRangeClamped(0.0f, 10.0f, 0.0f, 1.0f, 15.0f), 1.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::MapRangeClamped(0.0f, 10.0f, 2.0f, 4.0f, 2.5f), 2.5f);
+	// Empty input ranges step at the max, like FMath::GetRangePct
+	ALS_CHECK_NEAR(FALSLocomotionCore::MapRangeClamped(5.0f, 5.0f, 0.0f, 1.0f, 4.0f), 0.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::MapRangeClamped(5.0f, 5.0f, 0.0f, 1.0f, 5.0f), 1.0f);
+}
+
+static void TestGaits()
+{
+	const FALSGaitSpeeds Speeds{165.0f, 350.0f, 600.0f};
+	ALS_CHECK_NEAR(FALSLocomotionCore::GetMappedSpeed(0.0f, Speeds), 0.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::GetMappedSpeed(165.0f, Speeds), 1.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::GetMappedSpeed(350.0f, Speeds), 2.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::GetMappedSpeed(475.0f, Speeds), 2.5f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::GetMappedSpeed(900.0f, Speeds), 3.0f);
+
+	ALS_CHECK(FALSLocomotionCore::GetActualGait(600.0f, Speeds, EALSCoreGait::Fast) == EALSCoreGait::Fast);
+	// Still running while decelerating from a sprint that isn't allowed anymore
+	ALS_CHECK(FALSLocomotionCore::GetActualGait(600.0f, Speeds, EALSCoreGait::Normal) == EALSCoreGait::Normal);
+	ALS_CHECK(FALSLocomotionCore::GetActualGait(360.0f, Speeds, EALSCoreGait::Fast) == EALSCoreGait::Normal);
+	ALS_CHECK(FALSLocomotionCore::GetActualGait(100.0f, Speeds, EALSCoreGait::Fast) == EALSCoreGait::Slow);
+
+	ALS_CHECK(FALSLocomotionCore::GetAllowedGait(EALSCoreStance::Crouching, EALSCoreRotationMode::VelocityDirection,
+												 EALSCoreGait::Fast, true) == EALSCoreGait::Normal);
+	ALS_CHECK(FALSLocomotionCore::GetAllowedGait(EALSCoreStance::Standing, EALSCoreRotationMode::Aiming,
+												 EALSCoreGait::Fast, true) == EALSCoreGait::Normal);
+	ALS_CHECK(FALSLocomotionCore::GetAllowedGait(EALSCoreStance::Standing, EALSCoreRotationMode::VelocityDirection,
+												 EALSCoreGait::Fast, false) == EALSCoreGait::Normal);
+	ALS_CHECK(FALSLocomotionCore::GetAllowedGait(EALSCoreStance::Crouching, EALSCoreRotationMode::Aiming,
+												 EALSCoreGait::Slow, false) == EALSCoreGait::Slow);
+}
+
+static void TestCanSprint()
+{
+	FALSSprintInputs Inputs;
+	Inputs.bHasMovementInput = true;
+	Inputs.MovementInputAmount = 1.0f;
+	ALS_CHECK(FALSLocomotionCore::CanSprint(Inputs));
+
+	Inputs.MovementInputAmount = 0.5f;
+	ALS_CHECK(!FALSLocomotionCore::CanSprint(Inputs));
+
+	Inputs.MovementInputAmount = 1.0f;
+	Inputs.RotationMode = EALSCoreRotationMode::LookingDirection;
+	Inputs.InputAimYawDelta = -45.0f;
+	ALS_CHECK(FALSLocomotionCore::CanSprint(Inputs));
+	Inputs.InputAimYawDelta = 60.0f;
+	ALS_CHECK(!FALSLocomotionCore::CanSprint(Inputs));
+
+	Inputs.RotationMode = EALSCoreRotationMode::Aiming;
+	Inputs.InputAimYawDelta = 0.0f;
+	ALS_CHECK(!FALSLocomotionCore::CanSprint(Inputs));
+}
+
+static void TestAutoHover()
+{
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateAutoHover(EALSCoreFlightMode::None, 1.0f, 1.0f, 1.0f, 1.0f), 0.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateAutoHover(EALSCoreFlightMode::Neutral, 1.0f, 1.0f, 1.0f, 1.0f), 1.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateAutoHover(EALSCoreFlightMode::Raising, 1.0f, 1.0f, 1.0f, 1.0f), 3.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateAutoHover(EALSCoreFlightMode::Lowering, 1.0f, 1.0f, 1.0f, 1.0f), -1.5f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateAutoHover(EALSCoreFlightMode::Hovering, 1.0f, 1.0f, 1.0f, 1.0f), 0.5f);
+}
+
+static void TestDiagonalGamepadAxis()
+{
+	ALS_CHECK_NEAR(FALSLocomotionCore::FixDiagonalGamepadAxis(0.5f, 0.0f), 0.5f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::FixDiagonalGamepadAxis(0.5f, 0.3f), 0.55f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::FixDiagonalGamepadAxis(0.9f, 1.0f), 1.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::FixDiagonalGamepadAxis(-0.9f, -1.0f), -1.0f);
+}
+
+static void TestQuadrant()
+{
+	const auto Quadrant = [](const EALSCoreMovementDirection Current, const float Angle)
+	{
+		return FALSLocomotionCore::CalculateQuadrant(Current, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Angle);
+	};
+	ALS_CHECK(Quadrant(EALSCoreMovementDirection::Forward, 0.0f) == EALSCoreMovementDirection::Forward);
+	ALS_CHECK(Quadrant(EALSCoreMovementDirection::Forward, 90.0f) == EALSCoreMovementDirection::Right);
+	ALS_CHECK(Quadrant(EALSCoreMovementDirection::Forward, -90.0f) == EALSCoreMovementDirection::Left);
+	ALS_CHECK(Quadrant(EALSCoreMovementDirection::Forward, 180.0f) == EALSCoreMovementDirection::Backward);
+	ALS_CHECK(Quadrant(EALSCoreMovementDirection::Forward, -180.0f) == EALSCoreMovementDirection::Backward);
+	// The buffer widens the ranges, so the first matching quadrant wins near the thresholds
+	ALS_CHECK(Quadrant(EALSCoreMovementDirection::Right, 73.0f) == EALSCoreMovementDirection::Forward);
+
+	ALS_CHECK(FALSLocomotionCore::AngleInRange(74.0f, -70.0f, 70.0f, 5.0f, true));
+	ALS_CHECK(!FALSLocomotionCore::AngleInRange(66.0f, -70.0f, 70.0f, 5.0f, false));
+}
+
+static void TestVelocityBlend()
+{
+	const FALSDirectionalBlend Forward = FALSLocomotionCore::CalculateVelocityBlend({1.0f, 0.0f, 0.0f});
+	ALS_CHECK_NEAR(Forward.F, 1.0f);
+	ALS_CHECK_NEAR(Forward.B, 0.0f);
+	ALS_CHECK_NEAR(Forward.L, 0.0f);
+	ALS_CHECK_NEAR(Forward.R, 0.0f);
+
+	const float Diagonal = std::sqrt(0.5f);
+	const FALSDirectionalBlend BackLeft = FALSLocomotionCore::CalculateVelocityBlend({-Diagonal, -Diagonal, 0.0f});
+	ALS_CHECK_NEAR(BackLeft.F, 0.0f);
+	ALS_CHECK_NEAR(BackLeft.B, 0.5f);
+	ALS_CHECK_NEAR(BackLeft.L, 0.5f);
+	ALS_CHECK_NEAR(BackLeft.R, 0.0f);
+}
+
+static void TestAccelerationAmount()
+{
+	// Accelerating along the velocity is scaled by the max acceleration
+	const FALSCoreVector Accelerating =
+		FALSLocomotionCore::CalculateAccelerationAmount({400.0f, 0.0f, 0.0f}, {100.0f, 0.0f, 0.0f}, 800.0f, 2000.0f);
+	ALS_CHECK_NEAR(Accelerating.X, 0.5f);
+
+	// Braking is scaled by the max braking deceleration
+	const FALSCoreVector Braking =
+		FALSLocomotionCore::CalculateAccelerationAmount({-1000.0f, 0.0f, 0.0f}, {100.0f, 0.0f, 0.0f}, 800.0f, 2000.0f);
+	ALS_CHECK_NEAR(Braking.X, -0.5f);
+
+	// Longer accelerations are clamped to 1
+	const FALSCoreVector Clamped =
+		FALSLocomotionCore::CalculateAccelerationAmount({0.0f, 3000.0f, 4000.0f}, {0.0f, 1.0f, 0.0f}, 800.0f, 2000.0f);
+	ALS_CHECK_NEAR(Clamped.Y, 0.6f);
+	ALS_CHECK_NEAR(Clamped.Z, 0.8f);
+
+	const FALSCoreVector Zero = FALSLocomotionCore::GetClampedToMaxSize({1.0f, 2.0f, 3.0f}, 0.0f);
+	ALS_CHECK(Zero.X == 0.0f && Zero.Y == 0.0f && Zero.Z == 0.0f);
+}
+
+static void TestAnimGraph()
+{
+	ALS_CHECK_NEAR(FALSLocomotionCore::GetAnimCurveClamped(2.5f, -1.0f, 0.0f, 1.0f), 1.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::GetAnimCurveClamped(1.25f, -1.0f, 0.0f, 1.0f), 0.25f);
+
+	// Walking, running and fully crouched
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateStrideBlend(0.2f, 0.6f, 0.4f, 1.0f, 0.0f), 0.2f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateStrideBlend(0.2f, 0.6f, 0.4f, 2.0f, 0.0f), 0.6f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateStrideBlend(0.2f, 0.6f, 0.4f, 2.0f, 1.0f), 0.4f);
+
+	const FALSAnimatedSpeeds AnimatedSpeeds;
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateStandingPlayRate(150.0f, AnimatedSpeeds, 1.0f, 1.0f, 1.0f), 1.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateStandingPlayRate(350.0f, AnimatedSpeeds, 2.0f, 1.0f, 1.0f), 1.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateStandingPlayRate(600.0f, AnimatedSpeeds, 3.0f, 1.0f, 1.0f), 1.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateStandingPlayRate(350.0f, AnimatedSpeeds, 2.0f, 0.5f, 1.0f), 2.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateStandingPlayRate(5000.0f, AnimatedSpeeds, 1.0f, 1.0f, 1.0f), 3.0f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateCrouchingPlayRate(75.0f, AnimatedSpeeds, 1.0f, 1.0f), 0.5f);
+	ALS_CHECK_NEAR(FALSLocomotionCore::CalculateCrouchingPlayRate(600.0f, AnimatedSpeeds, 1.0f, 1.0f), 2.0f);
+
+	const FALSLeanValues Lean = FALSLocomotionCore::CalculateAirLeanAmount(350.0f, -175.0f, -1.0f);
+	ALS_CHECK_NEAR(Lean.LR, 0.5f);
+	ALS_CHECK_NEAR(Lean.FB, -1.0f);
+}
+
+int main()
+{
+	TestMapRangeClamped();
+	TestGaits();
+	TestCanSprint();
+	TestAutoHover();
+	TestDiagonalGamepadAxis();
+	TestQuadrant();
+	TestVelocityBlend();
+	TestAccelerationAmount();
+	TestAnimGraph();
+
+	if (Failures > 0)
+	{
+		std::printf("%d checks failed\n", Failures);
+		return 1;
+	}
+
+	std::printf("All checks passed\n");
+	return 0;
+}